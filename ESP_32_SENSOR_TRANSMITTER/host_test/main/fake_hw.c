@@ -0,0 +1,209 @@
+/*=============================================================================
+	File Name:	fake_hw.c
+	Author:		Vraj Patel, Samip Patel
+	Date:		17/10/2026
+	Modified:	17/10/2026
+	© Fanshawe College, 2025
+
+	Description: This file contains the fake ESP32 peripherals sensors.c and
+    bmx20_i2c.c are built against on the linux target: GPIO calls that read the
+    test-set levels and run the IR interrupt handlers on a change, the legacy I²C command-link API running each link against the
+    BMX-20 emulator, and an esp_timer that keeps the emulator's clock in step with
+    the host clock, so FreeRTOS delays in bmx20_i2c.c let conversions finish.
+=============================================================================*/
+
+#include <string.h>
+#include <time.h>
+#include "fake_hw.h"
+#include "driver/gpio.h"
+#include "driver/i2c.h"
+#include "esp_timer.h"
+
+enum { CMD_START, CMD_WRITE, CMD_READ, CMD_STOP };
+
+#define FAKE_WR_MAX  16 // Bytes one transaction may write
+
+typedef struct {
+    size_t         cap;         // commands that fit
+    size_t         n;           // commands added
+    bool           overflow;    // a command did not fit
+    fake_i2c_cmd_t cmd[];
+} fake_link_t; // Static command link, carved out of the caller's buffer
+
+volatile uint32_t fake_gpio_in[2];
+int               fake_spill_level;
+bmx20_emu_t       fake_env_bus;
+size_t            fake_i2c_link_hwm;
+
+esp_err_t gpio_config(const gpio_config_t *cfg) { return ESP_OK; }
+int       gpio_get_level(gpio_num_t gpio) { return gpio == GPIO_NUM_32 ? fake_spill_level : 0; }
+esp_err_t gpio_install_isr_service(int flags) { return ESP_OK; }
+
+#define FAKE_GPIO_COUNT  40 // GPIO0..39
+
+static gpio_isr_t s_gpio_isr[FAKE_GPIO_COUNT];     // handler per pin, run by fake_gpio_set()
+static void      *s_gpio_isr_arg[FAKE_GPIO_COUNT];
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio, gpio_isr_t isr, void *arg)
+{
+    s_gpio_isr[gpio]     = isr;
+    s_gpio_isr_arg[gpio] = arg;
+    return ESP_OK;
+}
+
+/*>>> fake_gpio_set: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will drive an input pin and, if its level changed, run
+			the pin's interrupt handler as an any-edge interrupt would.
+Input: 		- gpio: Pin
+			- level: New level (0 or 1)
+Returns:	None
+ ============================================================================*/
+void fake_gpio_set(gpio_num_t gpio, int level)
+{
+    volatile uint32_t *reg = &fake_gpio_in[gpio / 32];
+    uint32_t bit = 1u << (gpio % 32);
+    uint32_t old = *reg;
+    *reg = level ? (old | bit) : (old & ~bit);
+    if (((old & bit) != 0) != (level != 0) && s_gpio_isr[gpio]) {
+        s_gpio_isr[gpio](s_gpio_isr_arg[gpio]);
+    }
+}// eo fake_gpio_set::
+
+/*>>> esp_timer_get_time: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will bring the emulator's clock up to the host clock and
+			return it. The emulator may run ahead (wire time, or a test stepping
+			it), never behind.
+Input: 		None
+Returns:	Time in µs.
+ ============================================================================*/
+int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    int64_t host = (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+    if (host > fake_env_bus.now_us) {
+        fake_env_bus.now_us = host;
+    }
+    return fake_env_bus.now_us;
+}// eo esp_timer_get_time::
+
+/*>>> _link_add: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will append one command to a link if it fits.
+Input: 		- cmd: Link
+			- c: Command
+Returns:	ESP_OK, or ESP_ERR_NO_MEM if the link's buffer is full.
+ ============================================================================*/
+static esp_err_t _link_add(i2c_cmd_handle_t cmd, fake_i2c_cmd_t c)
+{
+    fake_link_t *link = cmd;
+    if (link->n == link->cap) {
+        link->overflow = true;
+        return ESP_ERR_NO_MEM;
+    }
+    link->cmd[link->n++] = c;
+    if (link->n > fake_i2c_link_hwm) {
+        fake_i2c_link_hwm = link->n;
+    }
+    return ESP_OK;
+}// eo _link_add::
+
+i2c_cmd_handle_t i2c_cmd_link_create_static(uint8_t *buffer, uint32_t size)
+{
+    if (!buffer || size < 2 * I2C_INTERNAL_STRUCT_SIZE) {
+        return NULL;
+    }
+    fake_link_t *link = (fake_link_t *)buffer;
+    link->cap      = (size - sizeof(fake_link_t)) / sizeof(fake_i2c_cmd_t);
+    link->n        = 0;
+    link->overflow = false;
+    return link;
+}
+
+void i2c_cmd_link_delete_static(i2c_cmd_handle_t cmd) {}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd)
+{
+    return _link_add(cmd, (fake_i2c_cmd_t){ .op = CMD_START });
+}
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd, uint8_t data, bool ack_en)
+{
+    return _link_add(cmd, (fake_i2c_cmd_t){ .op = CMD_WRITE, .byte = data, .len = 1 });
+}
+
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd, const uint8_t *data, size_t len, bool ack_en)
+{
+    return _link_add(cmd, (fake_i2c_cmd_t){ .op = CMD_WRITE, .wr = data, .len = len });
+}
+
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd, uint8_t *data, size_t len, i2c_ack_type_t ack)
+{
+    return _link_add(cmd, (fake_i2c_cmd_t){ .op = CMD_READ, .rd = data, .len = len });
+}
+
+esp_err_t i2c_master_read_byte(i2c_cmd_handle_t cmd, uint8_t *data, i2c_ack_type_t ack)
+{
+    return _link_add(cmd, (fake_i2c_cmd_t){ .op = CMD_READ, .rd = data, .len = 1 });
+}
+
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd)
+{
+    return _link_add(cmd, (fake_i2c_cmd_t){ .op = CMD_STOP });
+}
+
+/*>>> i2c_master_cmd_begin: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will run a link as one emulator transaction: the bytes
+			after the first address byte are the write phase, the reads after the
+			repeated start fill one contiguous destination.
+Input: 		- port: Unused
+			- cmd: Link
+			- ticks_to_wait: Unused
+Returns:	The emulator's result, or ESP_ERR_INVALID_STATE if the link overflowed
+			(the real driver would send it truncated) or is malformed.
+ ============================================================================*/
+esp_err_t i2c_master_cmd_begin(i2c_port_t port, i2c_cmd_handle_t cmd, TickType_t ticks_to_wait)
+{
+    fake_link_t *link = cmd;
+    uint8_t  wr[FAKE_WR_MAX];
+    size_t   wr_len = 0, rd_len = 0;
+    uint8_t *rd = NULL;
+    int      addr = -1;
+    bool     expect_addr = false;
+    if (link->overflow) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_timer_get_time(); // emulator clock up to now
+    for (size_t i = 0; i < link->n; i++) {
+        const fake_i2c_cmd_t *c = &link->cmd[i];
+        if (c->op == CMD_START) {
+            expect_addr = true;
+        } else if (c->op == CMD_WRITE && expect_addr) {
+            addr        = c->byte >> 1;
+            expect_addr = false;
+        } else if (c->op == CMD_WRITE) {
+            if (wr_len + c->len > sizeof(wr)) return ESP_ERR_INVALID_STATE;
+            memcpy(wr + wr_len, c->wr ? c->wr : &c->byte, c->len);
+            wr_len += c->len;
+        } else if (c->op == CMD_READ) {
+            if (rd && c->rd != rd + rd_len) return ESP_ERR_INVALID_STATE;
+            rd      = rd ? rd : c->rd;
+            rd_len += c->len;
+        }
+    }
+    if (addr < 0 || link->cmd[link->n - 1].op != CMD_STOP) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return fake_env_bus.base.xfer(&fake_env_bus.base, (uint8_t)addr, wr, wr_len, rd, rd_len);
+}// eo i2c_master_cmd_begin::
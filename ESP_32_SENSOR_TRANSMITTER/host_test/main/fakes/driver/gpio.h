@@ -0,0 +1,42 @@
+/*===================================================================================================
+File Name:	gpio.h (host fake)
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the part of the ESP-IDF GPIO driver that sensors.c uses, for the
+linux target, which has no GPIO driver. Implemented by fake_hw.c.
+===================================================================================================*/
+#ifndef FAKE_DRIVER_GPIO_H
+#define FAKE_DRIVER_GPIO_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef enum {
+    GPIO_NUM_12 = 12, GPIO_NUM_13, GPIO_NUM_14, GPIO_NUM_15, GPIO_NUM_16, GPIO_NUM_17,
+    GPIO_NUM_18, GPIO_NUM_19, GPIO_NUM_23 = 23, GPIO_NUM_25 = 25, GPIO_NUM_32 = 32,
+} gpio_num_t;
+
+typedef enum { GPIO_MODE_INPUT = 1 } gpio_mode_t;
+typedef enum { GPIO_PULLUP_DISABLE, GPIO_PULLUP_ENABLE } gpio_pullup_t;
+typedef enum { GPIO_PULLDOWN_DISABLE, GPIO_PULLDOWN_ENABLE } gpio_pulldown_t;
+typedef enum { GPIO_INTR_DISABLE, GPIO_INTR_POSEDGE, GPIO_INTR_NEGEDGE, GPIO_INTR_ANYEDGE } gpio_int_type_t;
+
+typedef struct {
+    uint64_t        pin_bit_mask;
+    gpio_mode_t     mode;
+    gpio_pullup_t   pull_up_en;
+    gpio_pulldown_t pull_down_en;
+    gpio_int_type_t intr_type;
+} gpio_config_t;
+
+typedef void (*gpio_isr_t)(void *arg);
+
+esp_err_t gpio_config(const gpio_config_t *cfg);
+int       gpio_get_level(gpio_num_t gpio);
+esp_err_t gpio_install_isr_service(int flags);
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio, gpio_isr_t isr, void *arg);
+
+#endif // FAKE_DRIVER_GPIO_H
@@ -0,0 +1,54 @@
+/*===================================================================================================
+File Name:	i2c.h (host fake)
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the part of the legacy I²C driver that bmx20_i2c.c uses, for the
+linux target. Command links are built the way the real driver builds them: a static link is
+carved out of the caller's buffer, one entry per command, and a command that does not fit fails
+with ESP_ERR_NO_MEM. i2c_master_cmd_begin() runs the link against the BMX-20 emulator
+(fake_hw.c). I2C_LINK_RECOMMENDED_SIZE uses the real driver's formula.
+===================================================================================================*/
+#ifndef FAKE_DRIVER_I2C_H
+#define FAKE_DRIVER_I2C_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+typedef int i2c_port_t;
+
+#define I2C_NUM_0           0
+#define I2C_MASTER_WRITE    0
+#define I2C_MASTER_READ     1
+
+typedef enum { I2C_MASTER_ACK, I2C_MASTER_NACK } i2c_ack_type_t;
+
+typedef struct {
+    uint8_t        op;      // start, write, read or stop
+    uint8_t        byte;    // single byte written
+    const uint8_t *wr;      // bytes written (NULL: `byte`)
+    uint8_t       *rd;      // read destination
+    size_t         len;     // bytes written or read
+} fake_i2c_cmd_t; // One command of a link
+
+typedef void *i2c_cmd_handle_t;
+
+#define I2C_INTERNAL_STRUCT_SIZE      (sizeof(fake_i2c_cmd_t))
+#define I2C_LINK_RECOMMENDED_SIZE(n)  (2 * I2C_INTERNAL_STRUCT_SIZE + I2C_INTERNAL_STRUCT_SIZE * (5 * (n)))
+
+i2c_cmd_handle_t i2c_cmd_link_create_static(uint8_t *buffer, uint32_t size);
+void      i2c_cmd_link_delete_static(i2c_cmd_handle_t cmd);
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd);
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd, uint8_t data, bool ack_en);
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd, const uint8_t *data, size_t len, bool ack_en);
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd, uint8_t *data, size_t len, i2c_ack_type_t ack);
+esp_err_t i2c_master_read_byte(i2c_cmd_handle_t cmd, uint8_t *data, i2c_ack_type_t ack);
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd);
+esp_err_t i2c_master_cmd_begin(i2c_port_t port, i2c_cmd_handle_t cmd, TickType_t ticks_to_wait);
+
+#endif // FAKE_DRIVER_I2C_H
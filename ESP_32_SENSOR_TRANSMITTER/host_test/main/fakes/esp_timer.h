@@ -0,0 +1,18 @@
+/*===================================================================================================
+File Name:	esp_timer.h (host fake)
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the esp_timer call sensors.c and bmx20_i2c.c use. fake_hw.c
+answers it from the BMX-20 emulator's clock, kept in step with the host clock.
+===================================================================================================*/
+#ifndef FAKE_ESP_TIMER_H
+#define FAKE_ESP_TIMER_H
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
+
+#endif // FAKE_ESP_TIMER_H
@@ -0,0 +1,29 @@
+/*===================================================================================================
+File Name:	fake_hw.h
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the state behind the fake ESP32 peripherals the host tests build
+sensors.c and bmx20_i2c.c against (fake_hw.c): the GPIO input registers and their edge interrupts,
+the spill pin, and the BMX-20 emulator that answers every I²C command link. esp_timer keeps the
+emulator's clock in step with the host clock.
+===================================================================================================*/
+#ifndef FAKE_HW_H
+#define FAKE_HW_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "bmx20_emu.h"
+#include "driver/gpio.h"
+
+extern volatile uint32_t fake_gpio_in[2];   // GPIO_IN_REG, GPIO_IN1_REG
+extern int               fake_spill_level;  // gpio_get_level(SPILL_GPIO)
+extern bmx20_emu_t       fake_env_bus;      // what every I²C command link talks to
+extern size_t            fake_i2c_link_hwm; // most commands one link has held
+
+/// Drive an input pin; a change runs its interrupt handler (any edge).
+void fake_gpio_set(gpio_num_t gpio, int level);
+
+#endif // FAKE_HW_H
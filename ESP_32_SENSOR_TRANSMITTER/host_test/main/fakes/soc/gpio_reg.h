@@ -0,0 +1,19 @@
+/*===================================================================================================
+File Name:	gpio_reg.h (host fake)
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file maps the GPIO input registers onto fake_gpio_in, so the tests set the pin
+levels sensors.c reads.
+===================================================================================================*/
+#ifndef FAKE_SOC_GPIO_REG_H
+#define FAKE_SOC_GPIO_REG_H
+
+#include "fake_hw.h"
+
+#define GPIO_IN_REG   (&fake_gpio_in[0])  // GPIO0..31
+#define GPIO_IN1_REG  (&fake_gpio_in[1])  // GPIO32..39
+
+#endif // FAKE_SOC_GPIO_REG_H
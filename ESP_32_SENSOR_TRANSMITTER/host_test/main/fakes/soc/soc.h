@@ -0,0 +1,17 @@
+/*===================================================================================================
+File Name:	soc.h (host fake)
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the register access macro sensors.c samples the IR bank with.
+===================================================================================================*/
+#ifndef FAKE_SOC_SOC_H
+#define FAKE_SOC_SOC_H
+
+#include <stdint.h>
+
+#define REG_READ(reg)  (*(volatile uint32_t *)(reg))
+
+#endif // FAKE_SOC_SOC_H
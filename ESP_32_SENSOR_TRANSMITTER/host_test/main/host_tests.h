@@ -0,0 +1,17 @@
+/*===================================================================================================
+File Name:	host_tests.h
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file lists the groups of host tests run by test_main.c. Each group lives in its
+own test_*.c file and runs its tests with RUN_TEST().
+===================================================================================================*/
+#ifndef HOST_TESTS_H
+#define HOST_TESTS_H
+
+void run_bmx20_tests(void);
+void run_sensors_tests(void);
+
+#endif // HOST_TESTS_H
@@ -0,0 +1,211 @@
+/*=============================================================================
+	File Name:	test_bmx20.c
+	Author:		Vraj Patel, Samip Patel
+	Date:		17/10/2026
+	Modified:	None
+	© Fanshawe College, 2025
+
+	Description: This file contains the host tests of the BMX-20 driver over the emulator
+    bus: single pairs, pairs behind a TCA9548A read as one pipeline, per-point faults and
+    the BMP280 forced-mode pressure read. Durations are on the emulator's virtual clock,
+    so they are what the same traffic costs on a real 100 kHz bus. Timings are only
+    printed by the benchmark; the other tests assert on them.
+=============================================================================*/
+
+#include <stdio.h>
+#include "unity.h"
+#include "host_tests.h"
+#include "BMX_20.h"
+#include "bmx20_mux.h"
+#include "bmx20_emu.h"
+
+#define EMU_CLK_HZ   100000
+#define MUX_PAIRS    4
+#define PIPE_MAX_US  100000 // n pipelined pairs cost one conversion (~80 ms) plus wire time
+
+static bmx20_emu_t         s_emu;
+static bmx20_mux_t         s_mux;
+static bmx20_mux_channel_t s_chan[MUX_PAIRS];
+static bmx20_t             s_dev[MUX_PAIRS];
+static bmx20_t            *s_devp[MUX_PAIRS];
+
+/*>>> open_mux: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will fit pairs on the given mux channels (point i on
+			channel i reports 20+i °C, 40+i %) and initialise a device on every
+			channel, fitted or not.
+Input: 		- fitted: Bit i set if channel i has a pair
+			- init_errs: Receives each bmx20_init_bus() result
+Returns:	None
+ ============================================================================*/
+static void open_mux(uint8_t fitted, esp_err_t init_errs[MUX_PAIRS])
+{
+    bmx20_emu_init(&s_emu, EMU_CLK_HZ, BMX20_MUX_ADDR);
+    for (uint8_t ch = 0; ch < MUX_PAIRS; ch++) {
+        if (fitted & (1u << ch)) {
+            bmx20_emu_add_pair(&s_emu, ch, 20.0f + ch, 40.0f + ch);
+        }
+    }
+    bmx20_mux_init(&s_mux, &s_emu.base, BMX20_MUX_ADDR);
+    for (uint8_t ch = 0; ch < MUX_PAIRS; ch++) {
+        bmx20_mux_channel_init(&s_chan[ch], &s_mux, ch);
+        s_devp[ch]    = &s_dev[ch];
+        init_errs[ch] = bmx20_init_bus(&s_dev[ch], &s_chan[ch].base);
+    }
+    bmx20_emu_reset_counters(&s_emu);
+}// eo open_mux::
+
+static void test_single_pair(void)
+{
+    bmx20_t dev;
+    float t, h;
+    bmx20_emu_init(&s_emu, EMU_CLK_HZ, 0);
+    bmx20_emu_add_pair(&s_emu, 0, 21.5f, 40.0f);
+    TEST_ASSERT_EQUAL(ESP_OK, bmx20_init_bus(&dev, &s_emu.base));
+
+    int64_t t0 = s_emu.now_us;
+    TEST_ASSERT_EQUAL(ESP_OK, bmx20_read_env(&dev, &t, &h));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 21.5f, t);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 40.0f, h);
+    TEST_ASSERT_GREATER_THAN(BMX20_EMU_AHT_CONV_US, s_emu.now_us - t0);
+    TEST_ASSERT_LESS_THAN(PIPE_MAX_US, s_emu.now_us - t0);
+}
+
+static void test_mux_pipeline(void)
+{
+    esp_err_t init[MUX_PAIRS], errs[MUX_PAIRS];
+    float t[MUX_PAIRS], h[MUX_PAIRS];
+    open_mux(0x0F, init);
+    for (int i = 0; i < MUX_PAIRS; i++) TEST_ASSERT_EQUAL(ESP_OK, init[i]);
+
+    int64_t t0 = s_emu.now_us;
+    TEST_ASSERT_EQUAL(ESP_OK, bmx20_read_env_many(s_devp, MUX_PAIRS, t, h, errs));
+    int64_t pipelined = s_emu.now_us - t0;
+    for (int i = 0; i < MUX_PAIRS; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, errs[i]);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, 20.0f + i, t[i]);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, 40.0f + i, h[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, s_emu.conflicts);
+    TEST_ASSERT_LESS_THAN(PIPE_MAX_US, pipelined);
+
+    t0 = s_emu.now_us;
+    for (int i = 0; i < MUX_PAIRS; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, bmx20_read_env(&s_dev[i], &t[i], &h[i]));
+    }
+    int64_t sequential = s_emu.now_us - t0;
+    TEST_ASSERT_LESS_THAN(sequential / 3, pipelined);
+}
+
+static void test_mux_missing_pair(void)
+{
+    esp_err_t init[MUX_PAIRS], errs[MUX_PAIRS];
+    float t[MUX_PAIRS], h[MUX_PAIRS];
+    open_mux(0x0F & ~(1u << 2), init);
+    TEST_ASSERT_TRUE(init[2] != ESP_OK);
+
+    int64_t t0 = s_emu.now_us;
+    esp_err_t err = bmx20_read_env_many(s_devp, MUX_PAIRS, t, h, errs);
+    int64_t took = s_emu.now_us - t0;
+    TEST_ASSERT_EQUAL(errs[2], err);
+    TEST_ASSERT_TRUE(errs[2] != ESP_OK);
+    for (int i = 0; i < MUX_PAIRS; i++) {
+        if (i == 2) continue;
+        TEST_ASSERT_EQUAL(ESP_OK, errs[i]);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, 20.0f + i, t[i]);
+    }
+    TEST_ASSERT_LESS_THAN(PIPE_MAX_US, took);
+    TEST_ASSERT_EQUAL_UINT32(0, s_emu.conflicts);
+}
+
+static void test_mux_corrupt_frame(void)
+{
+    esp_err_t init[MUX_PAIRS], errs[MUX_PAIRS];
+    open_mux(0x0F, init);
+    s_emu.corrupt_next = 1; // the first point collected gets a bad CRC
+    bmx20_read_env_many(s_devp, MUX_PAIRS, NULL, NULL, errs);
+    int bad = 0;
+    for (int i = 0; i < MUX_PAIRS; i++) {
+        if (errs[i] == ESP_ERR_INVALID_CRC) bad++;
+        else TEST_ASSERT_EQUAL(ESP_OK, errs[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(1, bad);
+}
+
+static void test_forced_pressure(void)
+{
+    esp_err_t init[MUX_PAIRS];
+    float t, p;
+    open_mux(0x0F, init);
+    bmp280_config_t cfg = BMP280_CONFIG_DEFAULT;
+    cfg.mode = BMP280_MODE_FORCED;
+    TEST_ASSERT_EQUAL(ESP_OK, bmx20_bmp280_configure(&s_dev[1], &cfg));
+
+    int64_t t0 = s_emu.now_us;
+    TEST_ASSERT_EQUAL(ESP_OK, bmx20_read_pressure(&s_dev[1], &t, &p));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 25.08f, t);       // datasheet worked example
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 100653.25f, p);
+    TEST_ASSERT_GREATER_THAN(BMX20_EMU_BMP_CONV_US, s_emu.now_us - t0);
+}
+
+static void test_forced_pressure_timeout(void)
+{
+    esp_err_t init[MUX_PAIRS];
+    float t = -1.0f, p = -1.0f;
+    open_mux(0x0F, init);
+    bmp280_config_t cfg = BMP280_CONFIG_DEFAULT;
+    cfg.mode = BMP280_MODE_FORCED;
+    TEST_ASSERT_EQUAL(ESP_OK, bmx20_bmp280_configure(&s_dev[1], &cfg));
+
+    s_emu.pair[1].bmp_stuck = true;
+    TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, bmx20_read_pressure(&s_dev[1], &t, &p));
+    TEST_ASSERT_FLOAT_WITHIN(0.0f, -1.0f, t); // nothing written
+    TEST_ASSERT_FLOAT_WITHIN(0.0f, -1.0f, p);
+
+    s_emu.pair[1].bmp_stuck = false;
+    TEST_ASSERT_EQUAL(ESP_OK, bmx20_read_pressure(&s_dev[1], &t, &p));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 100653.25f, p);
+}
+
+static void test_mux_benchmark(void)
+{
+    esp_err_t init[MUX_PAIRS], errs[MUX_PAIRS];
+    float t[MUX_PAIRS], h[MUX_PAIRS];
+    open_mux(0x0F, init);
+    int64_t t0 = s_emu.now_us;
+    bmx20_read_env_many(s_devp, MUX_PAIRS, t, h, errs);
+    int64_t pipelined = s_emu.now_us - t0;
+    t0 = s_emu.now_us;
+    for (int i = 0; i < MUX_PAIRS; i++) {
+        bmx20_read_env(&s_dev[i], &t[i], &h[i]);
+    }
+    int64_t sequential = s_emu.now_us - t0;
+
+    open_mux(0x0F & ~(1u << 2), init);
+    t0 = s_emu.now_us;
+    bmx20_read_env_many(s_devp, MUX_PAIRS, t, h, errs);
+    int64_t missing = s_emu.now_us - t0;
+    printf("mux x%d bench: pipelined %lld us, sequential %lld us, #2 missing %lld us\n", MUX_PAIRS,
+           (long long)pipelined, (long long)sequential, (long long)missing);
+}
+
+/*>>> run_bmx20_tests: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will run the BMX-20 driver tests.
+Input: 		None
+Returns:	None
+ ============================================================================*/
+void run_bmx20_tests(void)
+{
+    RUN_TEST(test_single_pair);
+    RUN_TEST(test_mux_pipeline);
+    RUN_TEST(test_mux_missing_pair);
+    RUN_TEST(test_mux_corrupt_frame);
+    RUN_TEST(test_forced_pressure);
+    RUN_TEST(test_forced_pressure_timeout);
+    RUN_TEST(test_mux_benchmark);
+}// eo run_bmx20_tests::
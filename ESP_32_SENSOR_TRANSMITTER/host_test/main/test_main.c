@@ -0,0 +1,34 @@
+/*=============================================================================
+	File Name:	test_main.c
+	Author:		Vraj Patel, Samip Patel
+	Date:		17/10/2026
+	Modified:	None
+	© Fanshawe College, 2025
+
+	Description: This file contains the entry point of the host tests. It runs every
+    test group and exits with the number of failures, so the build can be used as a
+    pass/fail gate.
+=============================================================================*/
+
+#include <stdlib.h>
+#include "unity.h"
+#include "host_tests.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+/*>>> app_main: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will run all test groups and exit with the failure count.
+Input: 		None
+Returns:	None
+ ============================================================================*/
+void app_main(void)
+{
+    UNITY_BEGIN();
+    run_bmx20_tests();
+    run_sensors_tests();
+    exit(UNITY_END());
+}// eo app_main::
@@ -0,0 +1,260 @@
+/*=============================================================================
+	File Name:	test_sensors.c
+	Author:		Vraj Patel, Samip Patel
+	Date:		17/10/2026
+	Modified:	17/10/2026
+	© Fanshawe College, 2025
+
+	Description: This file contains the host tests of sensors_read() on the fake
+    peripherals of fake_hw.c, through the real bmx20_i2c.c: the values it fills in,
+    and that a steady stream of reads (triggered and blocking) never touches the heap,
+    command links included. IR edges driven through the fake GPIO interrupts check the
+    debounced occupancy changes the Transmitter sends as delta frames. malloc, calloc and
+    realloc are wrapped by the linker (-Wl,--wrap) and counted on this thread only,
+    so allocations of other FreeRTOS threads are not charged to sensors_read().
+=============================================================================*/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "host_tests.h"
+#include "fake_hw.h"
+#include "sensors.h"
+#include "esp_timer.h"
+
+#define EMU_CLK_HZ     100000
+#define ALLOC_CYCLES   25  // the blocking reads take a real conversion time each
+#define POLL_STEP_US   (OCC_POLL_MS * 1000) // virtual time between collect attempts
+#define BOUNCE_US      200                  // contact bounce, well inside IR_SETTLE_US
+#define MAX_CHANGES    8
+
+typedef struct {
+    int          n;
+    occ_change_t c[MAX_CHANGES];
+} change_log_t; // Changes reported by one sensors_poll_occupancy() call
+
+static __thread volatile bool s_counting; // count this thread's allocations
+static volatile uint32_t      s_allocs;   // volatile: GCC assumes malloc touches no globals
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *p, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    s_allocs += s_counting;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size)
+{
+    s_allocs += s_counting;
+    return __real_calloc(n, size);
+}
+
+void *__wrap_realloc(void *p, size_t size)
+{
+    s_allocs += s_counting;
+    return __real_realloc(p, size);
+}
+
+/*>>> open_sensors: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will fit one climate pair on the bus (21.5 °C, 40 %),
+			set slots 0 and 9 and the spill input high, and run sensors_init().
+Input: 		None
+Returns:	None
+ ============================================================================*/
+static void open_sensors(void)
+{
+    bmx20_emu_init(&fake_env_bus, EMU_CLK_HZ, 0);
+    bmx20_emu_add_pair(&fake_env_bus, 0, 21.5f, 40.0f);
+    fake_gpio_in[0]  = (1u << GPIO_NUM_12) | (1u << GPIO_NUM_25);
+    fake_gpio_in[1]  = 0;
+    fake_spill_level = 1;
+    TEST_ASSERT_EQUAL(ESP_OK, sensors_init());
+}// eo open_sensors::
+
+/*>>> check_sample: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will compare a sample with what open_sensors() set up.
+Input: 		- d: Sample
+Returns:	None
+ ============================================================================*/
+static void check_sample(const sensor_data_t *d)
+{
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 21.5f, d->temperature);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 40.0f, d->humidity);
+    TEST_ASSERT_EQUAL_UINT8(1, d->env_count);
+    TEST_ASSERT_EQUAL(ESP_OK, d->env[0].err);
+    for (int i = 0; i < PROX_COUNT; i++) {
+        TEST_ASSERT_EQUAL(i == 0 || i == 9, d->prox[i]);
+    }
+    TEST_ASSERT_TRUE(d->spill);
+}// eo check_sample::
+
+/*>>> read_triggered: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will trigger a conversion and poll sensors_read() every
+			OCC_POLL_MS of virtual time until it is collected.
+Input: 		- d: Receives the sample
+Returns:	The final sensors_read() result.
+ ============================================================================*/
+static esp_err_t read_triggered(sensor_data_t *d)
+{
+    esp_err_t err = sensors_env_trigger();
+    if (err != ESP_OK) {
+        return err;
+    }
+    while ((err = sensors_read(d)) == ESP_ERR_NOT_FINISHED) {
+        fake_env_bus.now_us += POLL_STEP_US;
+    }
+    return err;
+}// eo read_triggered::
+
+/*>>> log_change: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will record one occupancy change.
+Input: 		- change: Reported change
+			- ctx: The change_log_t to append to
+Returns:	None
+ ============================================================================*/
+static void log_change(const occ_change_t *change, void *ctx)
+{
+    change_log_t *log = ctx;
+    if (log->n < MAX_CHANGES) {
+        log->c[log->n] = *change;
+    }
+    log->n++;
+}// eo log_change::
+
+/*>>> poll_after: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will let `us` of virtual time pass, then poll the IR bank.
+Input: 		- us: Time to advance
+			- log: Receives the changes
+			- occ: Receives the debounced occupancy
+Returns:	None
+ ============================================================================*/
+static void poll_after(int64_t us, change_log_t *log, uint16_t *occ)
+{
+    fake_env_bus.now_us = esp_timer_get_time() + us;
+    log->n = 0;
+    int n = sensors_poll_occupancy(log_change, log, occ);
+    TEST_ASSERT_EQUAL(log->n, n);
+}// eo poll_after::
+
+static void test_occupancy_edges_become_deltas(void)
+{
+    change_log_t log;
+    uint16_t occ;
+    open_sensors();
+    // run the virtual clock well ahead of the host clock, so every edge time is exact
+    fake_env_bus.now_us = esp_timer_get_time() + 1000000;
+    poll_after(0, &log, &occ);
+    TEST_ASSERT_EQUAL(0, log.n);
+    TEST_ASSERT_EQUAL_UINT16((1u << 0) | (1u << 9), occ);
+
+    // place on slot 3: reported once it has held for IR_SETTLE_US, not before
+    fake_gpio_set(GPIO_NUM_15, 1);
+    poll_after(0, &log, &occ);
+    TEST_ASSERT_EQUAL(0, log.n);
+    poll_after(IR_SETTLE_US, &log, &occ);
+    TEST_ASSERT_EQUAL(1, log.n);
+    TEST_ASSERT_EQUAL_UINT8(3, log.c[0].slot);
+    TEST_ASSERT_TRUE(log.c[0].occupied);
+    TEST_ASSERT_EQUAL_UINT16((1u << 0) | (1u << 3) | (1u << 9), occ);
+
+    // pick from slot 0 with contact bounce: one change
+    fake_gpio_set(GPIO_NUM_12, 0);
+    fake_env_bus.now_us += BOUNCE_US;
+    fake_gpio_set(GPIO_NUM_12, 1);
+    fake_env_bus.now_us += BOUNCE_US;
+    fake_gpio_set(GPIO_NUM_12, 0);
+    poll_after(IR_SETTLE_US, &log, &occ);
+    TEST_ASSERT_EQUAL(1, log.n);
+    TEST_ASSERT_EQUAL_UINT8(0, log.c[0].slot);
+    TEST_ASSERT_FALSE(log.c[0].occupied);
+
+    // a real pulse shorter than a poll period still shows as two changes, in order
+    fake_gpio_set(GPIO_NUM_17, 1);
+    fake_env_bus.now_us += IR_SETTLE_US + BOUNCE_US;
+    fake_gpio_set(GPIO_NUM_17, 0);
+    poll_after(IR_SETTLE_US, &log, &occ);
+    TEST_ASSERT_EQUAL(2, log.n);
+    TEST_ASSERT_EQUAL_UINT8(5, log.c[0].slot);
+    TEST_ASSERT_TRUE(log.c[0].occupied);
+    TEST_ASSERT_EQUAL_UINT8(5, log.c[1].slot);
+    TEST_ASSERT_FALSE(log.c[1].occupied);
+    TEST_ASSERT_EQUAL_UINT16((1u << 3) | (1u << 9), occ);
+
+    // a quiet shelf reports nothing
+    poll_after(POLL_STEP_US, &log, &occ);
+    TEST_ASSERT_EQUAL(0, log.n);
+}
+
+static void test_read_fills_sample(void)
+{
+    sensor_data_t d;
+    open_sensors();
+    TEST_ASSERT_EQUAL(ESP_OK, sensors_read(&d));
+    check_sample(&d);
+    TEST_ASSERT_EQUAL(ESP_OK, read_triggered(&d));
+    check_sample(&d);
+}
+
+static void test_alloc_counter_works(void)
+{
+    s_allocs   = 0;
+    s_counting = true;
+    void *volatile p = malloc(16);
+    s_counting = false;
+    free(p);
+    TEST_ASSERT_EQUAL_UINT32(1, s_allocs);
+}
+
+static void test_read_does_not_allocate(void)
+{
+    sensor_data_t d;
+    int ok = 0;
+    open_sensors();
+
+    s_allocs   = 0;
+    s_counting = true;
+    for (int k = 0; k < ALLOC_CYCLES; k++) {
+        ok += read_triggered(&d) == ESP_OK;
+        ok += sensors_read(&d) == ESP_OK;
+    }
+    s_counting = false;
+
+    TEST_ASSERT_EQUAL_INT(2 * ALLOC_CYCLES, ok);
+    TEST_ASSERT_EQUAL_UINT32(0, s_allocs);
+    TEST_ASSERT_TRUE(fake_i2c_link_hwm > 0); // the reads went through bmx20_i2c.c's links
+    check_sample(&d);
+}
+
+/*>>> run_sensors_tests: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will run the sensors_read() and occupancy tests.
+Input: 		None
+Returns:	None
+ ============================================================================*/
+void run_sensors_tests(void)
+{
+    RUN_TEST(test_read_fills_sample);
+    RUN_TEST(test_alloc_counter_works);
+    RUN_TEST(test_read_does_not_allocate);
+    RUN_TEST(test_occupancy_edges_become_deltas);
+}// eo run_sensors_tests::
@@ -2,7 +2,7 @@
 	File Name:	BMX_20.c
 	Author:		Vraj Patel, Samip Patel
 	Date:		10/07/2025
-	Modified:	None
+	Modified:	17/10/2026
 	© Fanshawe College, 2025
 
 	Description: This file contains the implementation of the BMX-20 sensor driver,
@@ -14,8 +14,6 @@
 // BMX_20.c
 #include "BMX_20.h"
 #include "esp_log.h"
-#include "freertos/task.h"
-#include "esp_rom_sys.h"
 
 static const char *TAG = "BMX20";
 
@@ -24,110 +22,237 @@ static const char *TAG = "BMX20";
 /*>>> i2c_write_reg: ==========================================================
 Author:		Patel Vraj, Samip Patel
 Date:		10/07/2025
-Modified:	None
+Modified:	17/10/2026
 Desc:		This function will write a byte to a specific register of the I2C device used for BMX-20 sensor.
-Input: 		- port: I2C port number
+Input: 		- dev: Pointer to the BMX-20 device structure
 			- addr: I2C device address
 			- reg: Register address to write to
 			- data: Data byte to write
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
-static esp_err_t i2c_write_reg(i2c_port_t port, uint8_t addr, uint8_t reg, uint8_t data)
+static esp_err_t i2c_write_reg(bmx20_t *dev, uint8_t addr, uint8_t reg, uint8_t data)
 {
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-      i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_WRITE, true);
-      i2c_master_write_byte(cmd, reg, true);
-      i2c_master_write_byte(cmd, data, true);
-    i2c_master_stop(cmd);
-    esp_err_t err = i2c_master_cmd_begin(port, cmd, pdMS_TO_TICKS(100));
-    i2c_cmd_link_delete(cmd);
-    return err;
+    const uint8_t wr[2] = { reg, data };
+    return dev->bus->xfer(dev->bus, addr, wr, sizeof(wr), NULL, 0);
 }// eo i2c_write_reg::
 
 /*>>> i2c_read_bytes: ==========================================================
 Author:		Patel Vraj, Samip Patel
 Date:		10/07/2025
-Modified:	None
-Desc:		This function will read a byte from a specific register of the I2C device used for BMX-20 sensor.
-Input: 		- port: I2C port number
+Modified:	17/10/2026
+Desc:		This function will read bytes starting at a specific register of the I2C device used for BMX-20 sensor.
+Input: 		- dev: Pointer to the BMX-20 device structure
 			- addr: I2C device address
 			- reg: Register address to read from
-			- data: Pointer to store the read data
+			- buf: Pointer to store the read data
+			- len: Number of bytes
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
-static esp_err_t i2c_read_bytes(i2c_port_t port, uint8_t addr, uint8_t reg, uint8_t *buf, size_t len)
-{
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    // set register pointer
-    i2c_master_start(cmd);
-      i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_WRITE, true);
-      i2c_master_write_byte(cmd, reg, true);
-    // read data back
-    i2c_master_start(cmd);
-      i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_READ, true);
-      if (len > 1) {
-          i2c_master_read(cmd, buf, len - 1, I2C_MASTER_ACK);
-      }
-      i2c_master_read_byte(cmd, buf + len - 1, I2C_MASTER_NACK);
-    i2c_master_stop(cmd);
-    esp_err_t err = i2c_master_cmd_begin(port, cmd, pdMS_TO_TICKS(100));
-    i2c_cmd_link_delete(cmd);
-    return err;
+static esp_err_t i2c_read_bytes(bmx20_t *dev, uint8_t addr, uint8_t reg, uint8_t *buf, size_t len)
+{
+    return dev->bus->xfer(dev->bus, addr, &reg, 1, buf, len);
 }// eo i2c_read_bytes::
 
-// --- BMP280 init & temperature ------------------------------------------------
+// --- BMP280 init, temperature & pressure --------------------------------------
+
+#define BMP280_REG_CALIB     0x88 // dig_T1..dig_P9, 24 bytes
+#define BMP280_REG_STATUS    0xF3
+#define BMP280_REG_CTRL_MEAS 0xF4
+#define BMP280_REG_CONFIG    0xF5
+#define BMP280_REG_PRESS     0xF7 // press_msb..temp_xlsb, 6 bytes
+#define BMP280_STATUS_MEASURING 0x08
 
 /*>>> bmp280_init: ==========================================================
 Author:		Patel Vraj, Samip Patel
 Date:		10/07/2025
-Modified:	None
-Desc:		This function will initialize the BMP280 sensor by reading its
-			calibration data and configuring the control register.
+Modified:	17/10/2026
+Desc:		This function will initialize the BMP280 sensor by reading its whole
+			calibration block in one transfer and applying the default settings.
 Input: 		- dev: Pointer to the BMX-20 device structure
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
 static esp_err_t bmp280_init(bmx20_t *dev)
 {
-    uint8_t calib[6];
-    // Read T1,T2,T3 calibration registers (0x88..0x8D)
-    esp_err_t err = i2c_read_bytes(dev->port, dev->addr_bmp280, 0x88, calib, sizeof(calib));
+    uint8_t c[24];
+    // Read T1..T3, P1..P9 calibration registers (0x88..0x9F)
+    esp_err_t err = i2c_read_bytes(dev, dev->addr_bmp280, BMP280_REG_CALIB, c, sizeof(c));
     if (err) {
         ESP_LOGE(TAG, "BMP280 cal read failed");
         return err;
     }
-    dev->dig_T1 = (uint16_t)(calib[0] | (calib[1] << 8));
-    dev->dig_T2 = (int16_t)(calib[2] | (calib[3] << 8));
-    dev->dig_T3 = (int16_t)(calib[4] | (calib[5] << 8));
+    dev->dig_T1 = (uint16_t)(c[0]  | (c[1]  << 8));
+    dev->dig_T2 = (int16_t)(c[2]   | (c[3]  << 8));
+    dev->dig_T3 = (int16_t)(c[4]   | (c[5]  << 8));
+    dev->dig_P1 = (uint16_t)(c[6]  | (c[7]  << 8));
+    dev->dig_P2 = (int16_t)(c[8]   | (c[9]  << 8));
+    dev->dig_P3 = (int16_t)(c[10]  | (c[11] << 8));
+    dev->dig_P4 = (int16_t)(c[12]  | (c[13] << 8));
+    dev->dig_P5 = (int16_t)(c[14]  | (c[15] << 8));
+    dev->dig_P6 = (int16_t)(c[16]  | (c[17] << 8));
+    dev->dig_P7 = (int16_t)(c[18]  | (c[19] << 8));
+    dev->dig_P8 = (int16_t)(c[20]  | (c[21] << 8));
+    dev->dig_P9 = (int16_t)(c[22]  | (c[23] << 8));
 
-    // Configure: osrs_t = 1 (<<5), osrs_p = 0, mode = Normal (3)
-    return i2c_write_reg(dev->port, dev->addr_bmp280, 0xF4, (1 << 5) | 3);
+    bmp280_config_t cfg = BMP280_CONFIG_DEFAULT;
+    return bmx20_bmp280_configure(dev, &cfg);
 }// eo bmp280_init::
 
-
-/*>>> bmx20_read_temperature: ==========================================================
-Author:		Patel Vraj, Samip Patel
-Date:		10/07/2025
+/*>>> bmx20_bmp280_configure: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
 Modified:	None
-Desc:		This function will initialize the BMX-20 sensor by reading its
-			calibration data and configuring the control register.
+Desc:		This function will write the BMP280 config and ctrl_meas registers. The
+			chip is put to sleep first, since config writes in normal mode may be ignored.
 Input: 		- dev: Pointer to the BMX-20 device structure
-			- temperature: Pointer to store the read temperature
+			- cfg: Oversampling, filter, standby and mode
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
-esp_err_t bmx20_read_temperature(bmx20_t *dev, float *temperature)
+esp_err_t bmx20_bmp280_configure(bmx20_t *dev, const bmp280_config_t *cfg)
 {
-    uint8_t data[3];
-    esp_err_t err = i2c_read_bytes(dev->port, dev->addr_bmp280, 0xFA, data, sizeof(data));
+    esp_err_t err = i2c_write_reg(dev, dev->addr_bmp280, BMP280_REG_CTRL_MEAS, BMP280_MODE_SLEEP);
+    if (err) return err;
+    err = i2c_write_reg(dev, dev->addr_bmp280, BMP280_REG_CONFIG,
+                        (cfg->standby << 5) | (cfg->filter << 2));
+    if (err) return err;
+    // In forced mode the conversion is started by each read
+    uint8_t mode = (cfg->mode == BMP280_MODE_FORCED) ? BMP280_MODE_SLEEP : cfg->mode;
+    err = i2c_write_reg(dev, dev->addr_bmp280, BMP280_REG_CTRL_MEAS,
+                        (cfg->osrs_t << 5) | (cfg->osrs_p << 2) | mode);
     if (err) return err;
+    dev->bmp_cfg = *cfg;
+    return ESP_OK;
+}// eo bmx20_bmp280_configure::
+
+/*>>> bmp280_measure_us: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will compute the maximum conversion time for the current
+			oversampling (datasheet: 1.25 + 2.3 * T + 2.3 * P + 0.575 ms).
+Input: 		- cfg: BMP280 settings
+Returns:	Conversion time in microseconds.
+ ============================================================================*/
+static uint32_t bmp280_measure_us(const bmp280_config_t *cfg)
+{
+    uint32_t us = 1250;
+    if (cfg->osrs_t) us += 2300 * (1u << (cfg->osrs_t - 1));
+    if (cfg->osrs_p) us += 2300 * (1u << (cfg->osrs_p - 1)) + 575;
+    return us;
+}// eo bmp280_measure_us::
 
-    int32_t adc_T = ((int32_t)data[0] << 12) | ((int32_t)data[1] << 4) | (data[2] >> 4);
+/*>>> bmp280_compensate_t: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will compensate a raw temperature with the datasheet's 32-bit
+			fixed-point formula and keep t_fine for the pressure compensation.
+Input: 		- dev: Pointer to the BMX-20 device structure
+			- adc_T: 20-bit raw temperature
+Returns:	Temperature in 0.01 °C.
+ ============================================================================*/
+static int32_t bmp280_compensate_t(bmx20_t *dev, int32_t adc_T)
+{
     int32_t var1 = ((((adc_T >> 3) - ((int32_t)dev->dig_T1 << 1))) * dev->dig_T2) >> 11;
     int32_t var2 = (((((adc_T >> 4) - dev->dig_T1) * ((adc_T >> 4) - dev->dig_T1)) >> 12) * dev->dig_T3) >> 14;
     dev->t_fine  = var1 + var2;
-    int32_t T100 = (dev->t_fine * 5 + 128) >> 8;  // T * 100
-    *temperature = T100 / 100.0f;
+    return (dev->t_fine * 5 + 128) >> 8;
+}// eo bmp280_compensate_t::
+
+/*>>> bmp280_compensate_p: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will compensate a raw pressure with the datasheet's 64-bit
+			fixed-point formula. Needs t_fine from the same burst.
+Input: 		- dev: Pointer to the BMX-20 device structure
+			- adc_P: 20-bit raw pressure
+Returns:	Pressure in Pa as Q24.8, or 0 if the calibration is invalid.
+ ============================================================================*/
+static uint32_t bmp280_compensate_p(const bmx20_t *dev, int32_t adc_P)
+{
+    int64_t var1 = (int64_t)dev->t_fine - 128000;
+    int64_t var2 = var1 * var1 * dev->dig_P6;
+    var2 += (var1 * dev->dig_P5) << 17;
+    var2 += (int64_t)dev->dig_P4 << 35;
+    var1  = ((var1 * var1 * dev->dig_P3) >> 8) + ((var1 * dev->dig_P2) << 12);
+    var1  = ((((int64_t)1 << 47) + var1) * dev->dig_P1) >> 33;
+    if (var1 == 0) {
+        return 0; // avoid division by zero
+    }
+    int64_t p = 1048576 - adc_P;
+    p    = (((p << 31) - var2) * 3125) / var1;
+    var1 = ((int64_t)dev->dig_P9 * (p >> 13) * (p >> 13)) >> 25;
+    var2 = ((int64_t)dev->dig_P8 * p) >> 19;
+    p    = ((p + var1 + var2) >> 8) + ((int64_t)dev->dig_P7 << 4);
+    return (uint32_t)p;
+}// eo bmp280_compensate_p::
+
+/*>>> bmx20_read_pressure: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will read temperature and pressure from one burst of
+			0xF7..0xFC, so both come from the same conversion. In forced mode it first
+			starts a conversion and sleeps through it, then polls the measuring bit for
+			up to 10 ms more.
+Input: 		- dev: Pointer to the BMX-20 device structure
+			- temperature: Pointer to store the temperature (°C), or NULL
+			- pressure: Pointer to store the pressure (Pa), or NULL
+Returns:	ESP_OK on success, ESP_ERR_TIMEOUT if the forced conversion did not finish,
+			or an error code on failure.
+ ============================================================================*/
+esp_err_t bmx20_read_pressure(bmx20_t *dev, float *temperature, float *pressure)
+{
+    const bmp280_config_t *cfg = &dev->bmp_cfg;
+    if (pressure && cfg->osrs_p == BMP280_OS_SKIP) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t err;
+    if (cfg->mode == BMP280_MODE_FORCED) {
+        err = i2c_write_reg(dev, dev->addr_bmp280, BMP280_REG_CTRL_MEAS,
+                            (cfg->osrs_t << 5) | (cfg->osrs_p << 2) | BMP280_MODE_FORCED);
+        if (err) return err;
+        dev->bus->sleep_until(dev->bus, dev->bus->now_us(dev->bus) + bmp280_measure_us(cfg));
+        uint8_t status;
+        int tries = 0;
+        while ((err = i2c_read_bytes(dev, dev->addr_bmp280, BMP280_REG_STATUS, &status, 1)) == ESP_OK
+               && (status & BMP280_STATUS_MEASURING) && ++tries < 10) {
+            dev->bus->sleep_until(dev->bus, dev->bus->now_us(dev->bus) + 1000);
+        }
+        if (err) return err;
+        if (status & BMP280_STATUS_MEASURING) {
+            return ESP_ERR_TIMEOUT; // still converting: the result registers hold the old sample
+        }
+    }
+
+    uint8_t d[6];
+    err = i2c_read_bytes(dev, dev->addr_bmp280, BMP280_REG_PRESS, d, sizeof(d));
+    if (err) return err;
+
+    int32_t adc_P = ((int32_t)d[0] << 12) | ((int32_t)d[1] << 4) | (d[2] >> 4);
+    int32_t adc_T = ((int32_t)d[3] << 12) | ((int32_t)d[4] << 4) | (d[5] >> 4);
+    int32_t T100  = bmp280_compensate_t(dev, adc_T);  // T * 100
+    if (temperature) {
+        *temperature = T100 / 100.0f;
+    }
+    if (pressure) {
+        *pressure = bmp280_compensate_p(dev, adc_P) / 256.0f;
+    }
     return ESP_OK;
+}// eo bmx20_read_pressure::
+
+/*>>> bmx20_read_temperature: ==========================================================
+Author:		Patel Vraj, Samip Patel
+Date:		10/07/2025
+Modified:	17/10/2026
+Desc:		This function will read the temperature from the BMP280 sensor.
+Input: 		- dev: Pointer to the BMX-20 device structure
+			- temperature: Pointer to store the read temperature
+Returns:	ESP_OK on success, or an error code on failure.
+ ============================================================================*/
+esp_err_t bmx20_read_temperature(bmx20_t *dev, float *temperature)
+{
+    return bmx20_read_pressure(dev, temperature, NULL);
 }// eo bmx20_read_temperature::
 
 // --- AHT20 humidity ------------------------------------------------------------
@@ -144,66 +269,225 @@ Returns:	ESP_OK on success, or an error code on failure.
 static esp_err_t aht20_trigger_measure(bmx20_t *dev)
 {
     const uint8_t cmd[3] = { 0xAC, 0x33, 0x00 };
-    i2c_cmd_handle_t c = i2c_cmd_link_create();
-    i2c_master_start(c);
-      i2c_master_write_byte(c, (dev->addr_aht20 << 1) | I2C_MASTER_WRITE, true);
-      i2c_master_write(c, (uint8_t *)cmd, sizeof(cmd), true);
-    i2c_master_stop(c);
-    esp_err_t err = i2c_master_cmd_begin(dev->port, c, pdMS_TO_TICKS(100));
-    i2c_cmd_link_delete(c);
-    return err;
+    return dev->bus->xfer(dev->bus, dev->addr_aht20, cmd, sizeof(cmd), NULL, 0);
 }// eo aht20_trigger_measure::
 
 
-/*>>> bmx20_read_humidity: ==========================================================
-Author:		Patel Vraj, Samip Patel
-Date:		10/07/2025
+/*>>> aht20_crc8: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will compute the AHT20 CRC-8 (poly 0x31, init 0xFF).
+Input: 		- p: Data
+			- n: Number of bytes
+Returns:	CRC byte.
+ ============================================================================*/
+static uint8_t aht20_crc8(const uint8_t *p, size_t n)
+{
+    uint8_t crc = 0xFF;
+    while (n--) {
+        crc ^= *p++;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}// eo aht20_crc8::
+
+/*>>> bmx20_humidity_trigger: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
 Modified:	None
-Desc:		This function will read the humidity from the AHT20 sensor.
+Desc:		This function will start an AHT20 conversion and note when it started; the
+			result is picked up later by bmx20_humidity_collect().
 Input: 		- dev: Pointer to the BMX-20 device structure
-			- humidity: Pointer to store the read humidity
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
-esp_err_t bmx20_read_humidity(bmx20_t *dev, float *humidity)
+esp_err_t bmx20_humidity_trigger(bmx20_t *dev)
 {
     esp_err_t err = aht20_trigger_measure(dev);
-    if (err) return err;
+    dev->aht_pending    = (err == ESP_OK);
+    dev->aht_started_us = dev->bus->now_us(dev->bus);
+    return err;
+}// eo bmx20_humidity_trigger::
 
-    // Wait for measurement (~80ms)
-    esp_rom_delay_us(80000);
+/*>>> bmx20_env_collect: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will collect a triggered AHT20 conversion without waiting: before
+			AHT20_MEASURE_US it returns at once, after that it reads the status byte and the
+			data in one transfer, reports ESP_ERR_NOT_FINISHED while the busy bit is set, and
+			checks the CRC byte before converting. The frame carries both the 20-bit humidity
+			and the 20-bit temperature, so one transfer gives both readings.
+Input: 		- dev: Pointer to the BMX-20 device structure
+			- temperature: Pointer to store the temperature (°C), or NULL
+			- humidity: Pointer to store the humidity (%), or NULL
+Returns:	ESP_OK, ESP_ERR_NOT_FINISHED, ESP_ERR_INVALID_CRC, ESP_ERR_TIMEOUT,
+			ESP_ERR_INVALID_STATE, or an I2C error.
+ ============================================================================*/
+esp_err_t bmx20_env_collect(bmx20_t *dev, float *temperature, float *humidity)
+{
+    if (!dev->aht_pending) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    int64_t elapsed = dev->bus->now_us(dev->bus) - dev->aht_started_us;
+    if (elapsed < AHT20_MEASURE_US) {
+        return ESP_ERR_NOT_FINISHED; // still converting, don't touch the bus
+    }
 
-    uint8_t buf[6];
-    err = i2c_read_bytes(dev->port, dev->addr_aht20, 0x00, buf, sizeof(buf));
+    // status, 5 data bytes, CRC
+    uint8_t buf[7];
+    esp_err_t err = dev->bus->xfer(dev->bus, dev->addr_aht20, NULL, 0, buf, sizeof(buf));
+    if (err == ESP_OK && (buf[0] & 0x80)) {
+        // busy bit: still converting
+        if (elapsed < AHT20_TIMEOUT_US) {
+            return ESP_ERR_NOT_FINISHED;
+        }
+        err = ESP_ERR_TIMEOUT;
+    }
+    dev->aht_pending = false;
     if (err) return err;
+    if (aht20_crc8(buf, 6) != buf[6]) {
+        ESP_LOGW(TAG, "AHT20 CRC mismatch");
+        return ESP_ERR_INVALID_CRC;
+    }
 
-    uint32_t raw_h = ((uint32_t)(buf[1] & 0x0F) << 16)
-                   | ((uint32_t)buf[2] << 8)
-                   |  (uint32_t)buf[3];
-    *humidity = (raw_h * 100.0f) / (1 << 20);
+    if (humidity) {
+        uint32_t raw_h = ((uint32_t)buf[1] << 12)
+                       | ((uint32_t)buf[2] << 4)
+                       |  (uint32_t)(buf[3] >> 4);
+        *humidity = (raw_h * 100.0f) / (1 << 20);
+    }
+    if (temperature) {
+        uint32_t raw_t = ((uint32_t)(buf[3] & 0x0F) << 16)
+                       | ((uint32_t)buf[4] << 8)
+                       |  (uint32_t)buf[5];
+        *temperature = (raw_t * 200.0f) / (1 << 20) - 50.0f;
+    }
     return ESP_OK;
-}// eo bmx20_read_humidity::
+}// eo bmx20_env_collect::
 
-// --- public init ---------------------------------------------------------------
+/*>>> bmx20_humidity_collect: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will collect only the humidity of a triggered conversion.
+Input: 		- dev: Pointer to the BMX-20 device structure
+			- humidity: Pointer to store the read humidity
+Returns:	As bmx20_env_collect().
+ ============================================================================*/
+esp_err_t bmx20_humidity_collect(bmx20_t *dev, float *humidity)
+{
+    return bmx20_env_collect(dev, NULL, humidity);
+}// eo bmx20_humidity_collect::
 
-/*>>> bmx20_init: ==========================================================
+/*>>> bmx20_read_env_many: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will read several AHT20s as one pipeline: every sensor is
+			triggered first, the task sleeps once for the conversion they share, and then
+			each one is collected (polling again only the ones still busy). N sensors take
+			about as long as one.
+Input: 		- devs: Sensors (each on its own bus or mux channel)
+			- n: Number of sensors
+			- temperature: n results (°C), or NULL
+			- humidity: n results (%), or NULL
+			- errs: n per-sensor results, or NULL
+Returns:	ESP_OK if every sensor was read, otherwise the first failure.
+ ============================================================================*/
+esp_err_t bmx20_read_env_many(bmx20_t *const devs[], size_t n,
+                              float *temperature, float *humidity, esp_err_t *errs)
+{
+    esp_err_t first = ESP_OK;
+    size_t busy = 0;
+    int64_t ready_at = 0;
+
+    // 1) Start every conversion
+    for (size_t i = 0; i < n; i++) {
+        esp_err_t err = bmx20_humidity_trigger(devs[i]);
+        if (err == ESP_OK) {
+            busy++;
+            ready_at = devs[i]->aht_started_us + AHT20_MEASURE_US;
+        } else if (first == ESP_OK) {
+            first = err;
+        }
+        if (errs) errs[i] = err;
+    }
+
+    // 2) One shared wait, then collect; retry only the sensors still converting
+    bmx20_bus_t *clock = n ? devs[0]->bus : NULL;
+    while (busy) {
+        clock->sleep_until(clock, ready_at);
+        busy = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (!devs[i]->aht_pending) continue;
+            esp_err_t err = bmx20_env_collect(devs[i],
+                                              temperature ? &temperature[i] : NULL,
+                                              humidity ? &humidity[i] : NULL);
+            if (err == ESP_ERR_NOT_FINISHED) {
+                busy++;
+                continue;
+            }
+            if (err && first == ESP_OK) first = err;
+            if (errs) errs[i] = err;
+        }
+        ready_at = clock->now_us(clock) + AHT20_POLL_MS * 1000;
+    }
+    return first;
+}// eo bmx20_read_env_many::
+
+/*>>> bmx20_read_env: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will read temperature and humidity from one AHT20 measurement.
+			The task sleeps through the conversion and then polls the busy bit.
+Input: 		- dev: Pointer to the BMX-20 device structure
+			- temperature: Pointer to store the temperature (°C), or NULL
+			- humidity: Pointer to store the humidity (%), or NULL
+Returns:	ESP_OK on success, or an error code on failure.
+ ============================================================================*/
+esp_err_t bmx20_read_env(bmx20_t *dev, float *temperature, float *humidity)
+{
+    return bmx20_read_env_many(&dev, 1, temperature, humidity, NULL);
+}// eo bmx20_read_env::
+
+/*>>> bmx20_read_humidity: ==========================================================
 Author:		Patel Vraj, Samip Patel
 Date:		10/07/2025
-Modified:	None
-Desc:		This function will initialize the BMX-20 sensor.
+Modified:	17/10/2026
+Desc:		This function will read the humidity from the AHT20 sensor. The task sleeps
+			through the conversion and then polls the busy bit, instead of spinning
+			the CPU for 80 ms.
 Input: 		- dev: Pointer to the BMX-20 device structure
+			- humidity: Pointer to store the read humidity
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
+esp_err_t bmx20_read_humidity(bmx20_t *dev, float *humidity)
+{
+    return bmx20_read_env(dev, NULL, humidity);
+}// eo bmx20_read_humidity::
 
-esp_err_t bmx20_init(bmx20_t *dev,
-                     i2c_port_t port,
-                     gpio_num_t sda_gpio,
-                     gpio_num_t scl_gpio,
-                     uint32_t clk_speed)
+// --- public init ---------------------------------------------------------------
+
+/*>>> bmx20_init_bus: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will initialize a BMX-20 pair reached through any bus
+			(the I²C port, a mux channel or the host emulator).
+Input: 		- dev: Pointer to the BMX-20 device structure
+			- bus: Bus the pair answers on; must outlive the device
+Returns:	ESP_OK on success, or an error code on failure.
+ ============================================================================*/
+esp_err_t bmx20_init_bus(bmx20_t *dev, bmx20_bus_t *bus)
 {
-    // CHANGE: removed bus setup here; I2C is already configured once in main.c
-    dev->port        = port;
+    dev->bus         = bus;
     dev->addr_aht20  = AHT20_I2C_ADDR;
     dev->addr_bmp280 = BMP280_I2C_ADDR;
+    dev->aht_pending = false;
 
     // Initialize BMP280 (reads calibration + sets control register)
     esp_err_t err = bmp280_init(dev);
@@ -213,4 +497,26 @@ esp_err_t bmx20_init(bmx20_t *dev,
     }
     // AHT20 needs no additional init
     return ESP_OK;
+}// eo bmx20_init_bus::
+
+#if !CONFIG_IDF_TARGET_LINUX
+/*>>> bmx20_init: ==========================================================
+Author:		Patel Vraj, Samip Patel
+Date:		10/07/2025
+Modified:	17/10/2026
+Desc:		This function will initialize the BMX-20 sensor wired straight to an I²C port.
+Input: 		- dev: Pointer to the BMX-20 device structure
+Returns:	ESP_OK on success, or an error code on failure.
+ ============================================================================*/
+
+esp_err_t bmx20_init(bmx20_t *dev,
+                     i2c_port_t port,
+                     gpio_num_t sda_gpio,
+                     gpio_num_t scl_gpio,
+                     uint32_t clk_speed)
+{
+    // CHANGE: removed bus setup here; I2C is already configured once in main.c
+    bmx20_i2c_open(&dev->i2c, port);
+    return bmx20_init_bus(dev, &dev->i2c.base);
 }// eo bmx20_init::
+#endif
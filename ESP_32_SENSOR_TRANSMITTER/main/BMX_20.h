@@ -3,7 +3,7 @@
 File Name:	BMX_20.h
 Author:		Vraj Patel, Samip Patel
 Date:		10/07/2025
-Modified:	7/08/2025
+Modified:	17/10/2026
 © Fanshawe College, 2025
 
 Description: This file contains the definition of the BMX-20 sensor driver,
@@ -14,9 +14,15 @@ configuration, and data reading.
 #define BMX_20_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "sdkconfig.h"
 #include "esp_err.h"
-#include "driver/i2c.h"
+#include "bmx20_bus.h"
+#if !CONFIG_IDF_TARGET_LINUX
 #include "driver/gpio.h"
+#include "bmx20_i2c.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,19 +31,95 @@ extern "C" {
 #define AHT20_I2C_ADDR    0x38
 #define BMP280_I2C_ADDR   0x77
 
+#define AHT20_MEASURE_US  80000  // Conversion time after a trigger (datasheet: ≥ 75 ms)
+#define AHT20_POLL_MS     10     // Status poll period while the AHT20 is still busy
+#define AHT20_TIMEOUT_US  200000 // Give up on a conversion after this long
+
+// BMP280 oversampling (ctrl_meas osrs_t / osrs_p)
+typedef enum {
+    BMP280_OS_SKIP = 0, // channel not measured
+    BMP280_OS_X1,
+    BMP280_OS_X2,
+    BMP280_OS_X4,
+    BMP280_OS_X8,
+    BMP280_OS_X16,
+} bmp280_os_t;
+
+// BMP280 IIR filter coefficient (config filter)
+typedef enum {
+    BMP280_FILTER_OFF = 0,
+    BMP280_FILTER_2,
+    BMP280_FILTER_4,
+    BMP280_FILTER_8,
+    BMP280_FILTER_16,
+} bmp280_filter_t;
+
+// BMP280 standby time between normal-mode conversions (config t_sb)
+typedef enum {
+    BMP280_STANDBY_0_5_MS = 0,
+    BMP280_STANDBY_62_5_MS,
+    BMP280_STANDBY_125_MS,
+    BMP280_STANDBY_250_MS,
+    BMP280_STANDBY_500_MS,
+    BMP280_STANDBY_1000_MS,
+    BMP280_STANDBY_2000_MS,
+    BMP280_STANDBY_4000_MS,
+} bmp280_standby_t;
+
+// BMP280 power mode (ctrl_meas mode)
+typedef enum {
+    BMP280_MODE_SLEEP  = 0,
+    BMP280_MODE_FORCED = 1, // one conversion per read, then back to sleep
+    BMP280_MODE_NORMAL = 3, // free-running, every standby period
+} bmp280_mode_t;
+
+typedef struct {
+    bmp280_os_t      osrs_t;
+    bmp280_os_t      osrs_p;
+    bmp280_filter_t  filter;
+    bmp280_standby_t standby;
+    bmp280_mode_t    mode;
+} bmp280_config_t;
+
+// Datasheet "indoor navigation" profile: lowest noise (~0.2 Pa RMS)
+#define BMP280_CONFIG_DEFAULT { \
+    .osrs_t  = BMP280_OS_X2,            \
+    .osrs_p  = BMP280_OS_X16,           \
+    .filter  = BMP280_FILTER_16,        \
+    .standby = BMP280_STANDBY_0_5_MS,   \
+    .mode    = BMP280_MODE_NORMAL,      \
+}
+
 typedef struct {
-    i2c_port_t port;
+    bmx20_bus_t *bus;           // where the transfers go
+#if !CONFIG_IDF_TARGET_LINUX
+    bmx20_i2c_t  i2c;           // bus used by bmx20_init()
+#endif
     uint8_t    addr_aht20;
     uint8_t    addr_bmp280;
     // BMP280 calibration params:
     uint16_t   dig_T1;
     int16_t    dig_T2;
     int16_t    dig_T3;
+    uint16_t   dig_P1;
+    int16_t    dig_P2, dig_P3, dig_P4, dig_P5, dig_P6, dig_P7, dig_P8, dig_P9;
     int32_t    t_fine;
+    bmp280_config_t bmp_cfg; // current BMP280 settings
+    // AHT20 conversion in progress
+    bool       aht_pending;     // triggered, not yet collected
+    int64_t    aht_started_us;  // esp_timer time of the trigger
 } bmx20_t;
 
 /**
- * @brief Initialize I2C peripheral and both sensors.
+ * @brief Initialize both sensors of a pair behind any bus (an I²C port, a
+ *        TCA9548A channel from bmx20_mux.h, or the host emulator in
+ *        bmx20_emu.h). The bus must outlive the device.
+ */
+esp_err_t bmx20_init_bus(bmx20_t *dev, bmx20_bus_t *bus);
+
+#if !CONFIG_IDF_TARGET_LINUX
+/**
+ * @brief Initialize both sensors wired straight to an installed I²C port.
  * @param dev         Pointer to your bmx20_t struct
  * @param port        I2C_NUM_0 or I2C_NUM_1
  * @param sda_gpio    GPIO_NUM_x for SDA line
@@ -50,17 +132,74 @@ esp_err_t bmx20_init(bmx20_t *dev,
                      gpio_num_t sda_gpio,
                      gpio_num_t scl_gpio,
                      uint32_t clk_speed);
+#endif
+
+/**
+ * @brief Apply BMP280 oversampling, IIR filter, standby and mode settings.
+ *        bmx20_init() applies BMP280_CONFIG_DEFAULT.
+ */
+esp_err_t bmx20_bmp280_configure(bmx20_t *dev, const bmp280_config_t *cfg);
 
 /**
- * @brief Read temperature (°C) from BMP280
+ * @brief Read temperature (°C) and pressure (Pa) from BMP280 in one burst.
+ *        Either pointer may be NULL. In forced mode this starts a conversion
+ *        and sleeps the task until it is done.
+ * @return ESP_ERR_INVALID_STATE if pressure is requested but osrs_p is SKIP,
+ *         ESP_ERR_TIMEOUT if a forced conversion is still running after the
+ *         expected time plus 10 ms (nothing is written).
+ */
+esp_err_t bmx20_read_pressure(bmx20_t *dev, float *temperature, float *pressure);
+
+/**
+ * @brief Read temperature (°C) from BMP280. bmx20_read_env() gives the
+ *        temperature together with the humidity in one AHT20 transfer.
  */
 esp_err_t bmx20_read_temperature(bmx20_t *dev, float *temperature);
 
 /**
- * @brief Read relative humidity (%) from AHT20
+ * @brief Read relative humidity (%) from AHT20. Blocks the calling task
+ *        (without spinning) for the conversion; prefer trigger/collect.
  */
 esp_err_t bmx20_read_humidity(bmx20_t *dev, float *humidity);
 
+/**
+ * @brief Start an AHT20 conversion and return at once.
+ */
+esp_err_t bmx20_humidity_trigger(bmx20_t *dev);
+
+/**
+ * @brief Collect the conversion started by bmx20_humidity_trigger().
+ * @return ESP_OK with *humidity set; ESP_ERR_NOT_FINISHED while the sensor is
+ *         still converting (call again later, no bus traffic before
+ *         AHT20_MEASURE_US); ESP_ERR_INVALID_CRC if the data was corrupted;
+ *         ESP_ERR_TIMEOUT if the sensor stayed busy; ESP_ERR_INVALID_STATE if
+ *         nothing was triggered.
+ */
+esp_err_t bmx20_humidity_collect(bmx20_t *dev, float *humidity);
+
+/**
+ * @brief Read temperature (°C) and relative humidity (%) from one AHT20
+ *        measurement. Either pointer may be NULL. Blocks like
+ *        bmx20_read_humidity().
+ */
+esp_err_t bmx20_read_env(bmx20_t *dev, float *temperature, float *humidity);
+
+/**
+ * @brief bmx20_read_env() for n pairs, pipelined: all AHT20s are triggered,
+ *        the task waits once, then all are collected, so n sensors take about
+ *        as long as one. Any of the output arrays may be NULL.
+ * @param errs  Per-sensor result
+ * @return ESP_OK if every sensor was read, otherwise the first failure
+ */
+esp_err_t bmx20_read_env_many(bmx20_t *const devs[], size_t n,
+                              float *temperature, float *humidity, esp_err_t *errs);
+
+/**
+ * @brief Like bmx20_humidity_collect(), also giving the temperature from the
+ *        same frame. Either pointer may be NULL.
+ */
+esp_err_t bmx20_env_collect(bmx20_t *dev, float *temperature, float *humidity);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,37 @@
+/*===================================================================================================
+File Name:	bmx20_bus.h
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the bus interface the BMX-20 driver talks through. The driver
+only builds AHT20/BMP280 transfers and keeps conversion deadlines; moving the bytes and keeping
+time is left to a bus, so the same driver runs on the legacy I²C driver (bmx20_i2c.c), behind a
+TCA9548A channel (bmx20_mux.c) or against the host-side emulator (bmx20_emu.c).
+===================================================================================================*/
+#ifndef BMX20_BUS_H
+#define BMX20_BUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef struct bmx20_bus bmx20_bus_t;
+
+/**
+ * @brief Transfers + clock under the BMX-20 driver.
+ * Implementations embed this as their first member.
+ */
+struct bmx20_bus {
+    /// One transaction with the device at `addr`: write `wr_len` bytes, then
+    /// (repeated start) read `rd_len` bytes. Either length may be 0.
+    esp_err_t (*xfer)(bmx20_bus_t *bus, uint8_t addr,
+                      const uint8_t *wr, size_t wr_len, uint8_t *rd, size_t rd_len);
+    /// Current time in µs, used for conversion deadlines.
+    int64_t   (*now_us)(bmx20_bus_t *bus);
+    /// Return once now_us() has reached `deadline_us` (sleeping, not spinning).
+    void      (*sleep_until)(bmx20_bus_t *bus, int64_t deadline_us);
+};
+
+#endif // BMX20_BUS_H
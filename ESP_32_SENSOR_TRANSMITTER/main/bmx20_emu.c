@@ -0,0 +1,269 @@
+/*=============================================================================
+	File Name:	bmx20_emu.c
+	Author:		Vraj Patel, Samip Patel
+	Date:		17/10/2026
+	Modified:	None
+	© Fanshawe College, 2025
+
+	Description: This file contains the host-side emulator bus of the BMX-20 driver:
+    a TCA9548A, AHT20s and BMP280s answering on a virtual clock.
+=============================================================================*/
+
+#include <string.h>
+#include "bmx20_emu.h"
+#include "BMX_20.h"
+
+// Datasheet calibration example and the raw sample it is worked through with
+static const uint8_t s_bmp_calib[24] = {
+    0x70, 0x6B, 0x43, 0x67, 0x18, 0xFC,             // T1 27504, T2 26435, T3 -1000
+    0x7D, 0x8E, 0x43, 0xD6, 0xD0, 0x0B, 0x27, 0x0B, // P1 36477, P2 -10685, P3 3024, P4 2855
+    0x8C, 0x00, 0xF9, 0xFF, 0x8C, 0x3C, 0xF8, 0xC6, // P5 140, P6 -7, P7 15500, P8 -14600
+    0x70, 0x17,                                     // P9 6000
+};
+#define EMU_ADC_P  415148
+#define EMU_ADC_T  519888
+
+/*>>> _emu_crc8: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will compute the AHT20 CRC-8 (poly 0x31, init 0xFF).
+Input: 		- p: Data
+			- n: Number of bytes
+Returns:	CRC byte.
+ ============================================================================*/
+static uint8_t _emu_crc8(const uint8_t *p, size_t n)
+{
+    uint8_t crc = 0xFF;
+    while (n--) {
+        crc ^= *p++;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}// eo _emu_crc8::
+
+/*>>> _emu_aht20: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will play the AHT20 side of a transaction: the trigger
+			command starts a conversion, a read returns status, data and CRC.
+Input: 		- emu: Pointer to the emulator
+			- p: Addressed pair
+			- wr / wr_len / rd / rd_len: As bmx20_bus_t::xfer
+Returns:	None
+ ============================================================================*/
+static void _emu_aht20(bmx20_emu_t *emu, bmx20_emu_pair_t *p,
+                       const uint8_t *wr, size_t wr_len, uint8_t *rd, size_t rd_len)
+{
+    if (wr_len >= 3 && wr[0] == 0xAC && wr[1] == 0x33) {
+        p->aht_ready_us = emu->now_us + BMX20_EMU_AHT_CONV_US;
+    }
+    if (!rd_len) return;
+
+    uint8_t f[7];
+    uint32_t h = (uint32_t)(p->humidity / 100.0f * (1 << 20));
+    uint32_t t = (uint32_t)((p->temperature + 50.0f) / 200.0f * (1 << 20));
+    if (h > 0xFFFFF) h = 0xFFFFF;
+    if (t > 0xFFFFF) t = 0xFFFFF;
+    f[0] = 0x18 | (emu->now_us < p->aht_ready_us ? 0x80 : 0); // calibrated, busy
+    f[1] = (uint8_t)(h >> 12);
+    f[2] = (uint8_t)(h >> 4);
+    f[3] = (uint8_t)((h << 4) | (t >> 16));
+    f[4] = (uint8_t)(t >> 8);
+    f[5] = (uint8_t)t;
+    f[6] = _emu_crc8(f, 6);
+    if (emu->corrupt_next) {
+        emu->corrupt_next--;
+        f[2] ^= 0x01;
+    }
+    memcpy(rd, f, rd_len < sizeof(f) ? rd_len : sizeof(f));
+}// eo _emu_aht20::
+
+/*>>> _emu_bmp280: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will play the BMP280 side of a transaction: written bytes
+			are register/value pairs (a lone register byte only sets the pointer),
+			reads auto-increment. Writing forced mode starts a conversion.
+Input: 		- emu: Pointer to the emulator
+			- p: Addressed pair
+			- wr / wr_len / rd / rd_len: As bmx20_bus_t::xfer
+Returns:	None
+ ============================================================================*/
+static void _emu_bmp280(bmx20_emu_t *emu, bmx20_emu_pair_t *p,
+                        const uint8_t *wr, size_t wr_len, uint8_t *rd, size_t rd_len)
+{
+    if (wr_len) {
+        p->bmp_ptr = wr[0];
+    }
+    for (size_t i = 0; i + 1 < wr_len; i += 2) {
+        uint8_t reg = wr[i];
+        uint8_t val = wr[i + 1];
+        if (reg == 0xF4 && (val & 0x03) && (val & 0x03) != 0x03) {
+            p->bmp_ready_us = emu->now_us + BMX20_EMU_BMP_CONV_US; // forced
+            val &= ~0x03;                                          // back to sleep after it
+        }
+        p->bmp[reg] = val;
+    }
+    p->bmp[0xF3] = (p->bmp_stuck || emu->now_us < p->bmp_ready_us) ? 0x08 : 0x00;
+    for (size_t i = 0; i < rd_len; i++) {
+        rd[i] = p->bmp[(uint8_t)(p->bmp_ptr + i)];
+    }
+}// eo _emu_bmp280::
+
+/*>>> _emu_xfer: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will clock a transaction into the emulator. The mux takes
+			a channel bitmask; any other address is routed to the pairs on the
+			selected channels. Each byte (and each address byte) takes 9 bit times
+			at the modeled SCL rate.
+Input: 		- bus: Pointer to the emulator
+			- addr / wr / wr_len / rd / rd_len: As bmx20_bus_t::xfer
+Returns:	ESP_OK, or ESP_FAIL when nobody or more than one device answered.
+ ============================================================================*/
+static esp_err_t _emu_xfer(bmx20_bus_t *bus, uint8_t addr,
+                           const uint8_t *wr, size_t wr_len, uint8_t *rd, size_t rd_len)
+{
+    bmx20_emu_t *emu = (bmx20_emu_t *)bus;
+    uint64_t bits = BMX20_EMU_I2C_BIT_OVERHEAD;
+    if (wr_len) bits += 9 * (uint64_t)(wr_len + 1);
+    if (rd_len) bits += 9 * (uint64_t)(rd_len + 1) + (wr_len ? 1 : 0);
+    uint32_t wire_us = (uint32_t)(bits * 1000000ULL / emu->clk_hz);
+    emu->now_us      += wire_us;
+    emu->bus_time_us += wire_us;
+    emu->transactions++;
+
+    if (emu->mux_addr && addr == emu->mux_addr) {
+        emu->mux_writes += wr_len ? 1 : 0;
+        if (wr_len) emu->mux_sel = wr[wr_len - 1];
+        for (size_t i = 0; i < rd_len; i++) rd[i] = emu->mux_sel;
+        return ESP_OK;
+    }
+    if (addr != AHT20_I2C_ADDR && addr != BMP280_I2C_ADDR) {
+        emu->nacks++;
+        return ESP_FAIL;
+    }
+
+    uint8_t sel = emu->mux_addr ? emu->mux_sel : 0x01;
+    bmx20_emu_pair_t *hit = NULL;
+    int answered = 0;
+    for (int ch = 0; ch < BMX20_MUX_CHANNELS; ch++) {
+        if ((sel & (1u << ch)) && emu->pair[ch].present) {
+            hit = &emu->pair[ch];
+            answered++;
+        }
+    }
+    if (answered == 0) {
+        emu->nacks++;
+        return ESP_FAIL;
+    }
+    if (answered > 1) {
+        emu->conflicts++;
+        return ESP_FAIL;
+    }
+    if (addr == AHT20_I2C_ADDR) {
+        _emu_aht20(emu, hit, wr, wr_len, rd, rd_len);
+    } else {
+        _emu_bmp280(emu, hit, wr, wr_len, rd, rd_len);
+    }
+    return ESP_OK;
+}// eo _emu_xfer::
+
+/*>>> _emu_now_us: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will return the virtual clock.
+Input: 		- bus: Pointer to the emulator
+Returns:	Virtual time in µs.
+ ============================================================================*/
+static int64_t _emu_now_us(bmx20_bus_t *bus)
+{
+    return ((bmx20_emu_t *)bus)->now_us;
+}// eo _emu_now_us::
+
+/*>>> _emu_sleep_until: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will advance the virtual clock to the deadline, so
+			driver waits cost no host time but still show up in now_us.
+Input: 		- bus: Pointer to the emulator
+			- deadline_us: Virtual time to advance to
+Returns:	None
+ ============================================================================*/
+static void _emu_sleep_until(bmx20_bus_t *bus, int64_t deadline_us)
+{
+    bmx20_emu_t *emu = (bmx20_emu_t *)bus;
+    if (deadline_us > emu->now_us) emu->now_us = deadline_us;
+}// eo _emu_sleep_until::
+
+/*>>> bmx20_emu_init: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will reset the emulator: no pairs fitted, no channel selected.
+Input: 		- emu: Pointer to the emulator
+			- clk_hz: Modeled SCL frequency
+			- mux_addr: Mux address, 0 for none
+Returns:	None
+ ============================================================================*/
+void bmx20_emu_init(bmx20_emu_t *emu, uint32_t clk_hz, uint8_t mux_addr)
+{
+    memset(emu, 0, sizeof(*emu));
+    emu->base.xfer        = _emu_xfer;
+    emu->base.now_us      = _emu_now_us;
+    emu->base.sleep_until = _emu_sleep_until;
+    emu->clk_hz           = clk_hz ? clk_hz : 100000;
+    emu->mux_addr         = mux_addr;
+}// eo bmx20_emu_init::
+
+/*>>> bmx20_emu_add_pair: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will fit a sensor pair on a channel.
+Input: 		- emu: Pointer to the emulator
+			- channel: Mux channel (0 without a mux)
+			- temperature / humidity: Climate the AHT20 reports
+Returns:	None
+ ============================================================================*/
+void bmx20_emu_add_pair(bmx20_emu_t *emu, uint8_t channel, float temperature, float humidity)
+{
+    bmx20_emu_pair_t *p = &emu->pair[channel % BMX20_MUX_CHANNELS];
+    memset(p, 0, sizeof(*p));
+    p->present     = true;
+    p->temperature = temperature;
+    p->humidity    = humidity;
+    memcpy(&p->bmp[0x88], s_bmp_calib, sizeof(s_bmp_calib));
+    p->bmp[0xD0] = 0x58; // chip ID
+    p->bmp[0xF7] = (uint8_t)(EMU_ADC_P >> 12);
+    p->bmp[0xF8] = (uint8_t)(EMU_ADC_P >> 4);
+    p->bmp[0xF9] = (uint8_t)(EMU_ADC_P << 4);
+    p->bmp[0xFA] = (uint8_t)(EMU_ADC_T >> 12);
+    p->bmp[0xFB] = (uint8_t)(EMU_ADC_T >> 4);
+    p->bmp[0xFC] = (uint8_t)(EMU_ADC_T << 4);
+}// eo bmx20_emu_add_pair::
+
+/*>>> bmx20_emu_reset_counters: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will zero the traffic counters.
+Input: 		- emu: Pointer to the emulator
+Returns:	None
+ ============================================================================*/
+void bmx20_emu_reset_counters(bmx20_emu_t *emu)
+{
+    emu->transactions = 0;
+    emu->mux_writes   = 0;
+    emu->bus_time_us  = 0;
+    emu->nacks        = 0;
+    emu->conflicts    = 0;
+}// eo bmx20_emu_reset_counters::
@@ -0,0 +1,70 @@
+/*===================================================================================================
+File Name:	bmx20_emu.h
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the interface for the host-side emulator bus of the BMX-20
+driver. It models a TCA9548A mux with an AHT20 + BMP280 pair on each populated channel (AHT20
+conversion time, busy bit and CRC; BMP280 register file, calibration and forced conversions) on a
+virtual clock, and counts the transactions and wire time the same traffic would cost on a real
+I²C bus. Two selected channels answering the same address are reported as a bus conflict.
+No hardware or ESP-IDF peripheral driver is needed, so it also builds for the linux target.
+===================================================================================================*/
+#ifndef BMX20_EMU_H
+#define BMX20_EMU_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "bmx20_bus.h"
+#include "bmx20_mux.h"
+
+#define BMX20_EMU_AHT_CONV_US     75000 // Modeled AHT20 conversion time
+#define BMX20_EMU_BMP_CONV_US     44000 // Modeled BMP280 forced conversion (x16 / x2)
+#define BMX20_EMU_I2C_BIT_OVERHEAD 2    // Start + stop, in bit times
+
+typedef struct {
+    bool     present;       // pair fitted on this channel
+    float    temperature;   // °C the AHT20 reports
+    float    humidity;      // % the AHT20 reports
+    int64_t  aht_ready_us;  // AHT20 busy until this virtual time
+    uint8_t  bmp[256];      // BMP280 register file
+    uint8_t  bmp_ptr;       // BMP280 register pointer
+    int64_t  bmp_ready_us;  // BMP280 measuring until this virtual time
+    bool     bmp_stuck;     // BMP280 measuring bit never clears (hung conversion)
+} bmx20_emu_pair_t; // One emulated AHT20 + BMP280
+
+typedef struct {
+    bmx20_bus_t base;           // must be first
+    uint32_t clk_hz;            // modeled SCL frequency
+    int64_t  now_us;            // virtual clock
+    uint8_t  mux_addr;          // mux address, 0 = no mux (pair 0 is on the bus itself)
+    uint8_t  mux_sel;           // mux control register (channel bitmask)
+    bmx20_emu_pair_t pair[BMX20_MUX_CHANNELS];
+    uint32_t corrupt_next;      // flip a bit in this many upcoming AHT20 frames
+    // counters
+    uint32_t transactions;      // I²C transactions
+    uint32_t mux_writes;        // of which mux selects
+    uint32_t bus_time_us;       // time those transactions spent on the wire
+    uint32_t nacks;             // transactions nobody answered
+    uint32_t conflicts;         // transactions answered by more than one device
+} bmx20_emu_t; // Emulated mux + sensor pairs
+
+/**
+ * @brief Reset the emulator and set it up as a bus with no pairs fitted.
+ * @param clk_hz    I²C clock used to model wire time (e.g. 100000)
+ * @param mux_addr  Mux address, or 0 to model a single pair without a mux
+ */
+void bmx20_emu_init(bmx20_emu_t *emu, uint32_t clk_hz, uint8_t mux_addr);
+
+/**
+ * @brief Fit a pair on `channel` reporting the given AHT20 climate. The BMP280
+ *        holds the datasheet's calibration and sample (25.08 °C, 100653 Pa).
+ */
+void bmx20_emu_add_pair(bmx20_emu_t *emu, uint8_t channel, float temperature, float humidity);
+
+/// Zero the traffic counters.
+void bmx20_emu_reset_counters(bmx20_emu_t *emu);
+
+#endif // BMX20_EMU_H
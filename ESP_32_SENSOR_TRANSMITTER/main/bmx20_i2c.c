@@ -0,0 +1,104 @@
+/*=============================================================================
+	File Name:	bmx20_i2c.c
+	Author:		Vraj Patel, Samip Patel
+	Date:		17/10/2026
+	Modified:	17/10/2026
+	© Fanshawe College, 2025
+
+	Description: This file contains the I²C bus of the BMX-20 driver: each transfer is
+    one command link on the legacy I²C driver, built in the bus's own buffer rather than
+    on the heap, and conversion waits are FreeRTOS delays timed with esp_timer.
+=============================================================================*/
+
+#include "bmx20_i2c.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+
+/*>>> _i2c_xfer: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will run one transaction: an optional write (register
+			pointer or command) followed by an optional read after a repeated start.
+			The command link lives in io->link, so no heap is used.
+Input: 		- bus: Pointer to the I²C bus
+			- addr: I2C device address
+			- wr / wr_len: Bytes to write (wr_len may be 0)
+			- rd / rd_len: Read destination (rd_len may be 0)
+Returns:	ESP_OK on success, or an error code on failure.
+ ============================================================================*/
+static esp_err_t _i2c_xfer(bmx20_bus_t *bus, uint8_t addr,
+                           const uint8_t *wr, size_t wr_len, uint8_t *rd, size_t rd_len)
+{
+    bmx20_i2c_t *io = (bmx20_i2c_t *)bus;
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(io->link, sizeof(io->link));
+    if (!cmd) {
+        return ESP_ERR_NO_MEM;
+    }
+    if (wr_len) {
+        i2c_master_start(cmd);
+          i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_WRITE, true);
+          i2c_master_write(cmd, (uint8_t *)wr, wr_len, true);
+    }
+    if (rd_len) {
+        i2c_master_start(cmd);
+          i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_READ, true);
+          if (rd_len > 1) {
+              i2c_master_read(cmd, rd, rd_len - 1, I2C_MASTER_ACK);
+          }
+          i2c_master_read_byte(cmd, rd + rd_len - 1, I2C_MASTER_NACK);
+    }
+    i2c_master_stop(cmd);
+    esp_err_t err = i2c_master_cmd_begin(io->port, cmd, pdMS_TO_TICKS(BMX20_I2C_TIMEOUT_MS));
+    i2c_cmd_link_delete_static(cmd);
+    return err;
+}// eo _i2c_xfer::
+
+/*>>> _i2c_now_us: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will return the esp_timer time.
+Input: 		- bus: Pointer to the I²C bus (unused)
+Returns:	Time in µs since boot.
+ ============================================================================*/
+static int64_t _i2c_now_us(bmx20_bus_t *bus)
+{
+    return esp_timer_get_time();
+}// eo _i2c_now_us::
+
+/*>>> _i2c_sleep_until: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will block the calling task until the deadline, rounding
+			up to whole ticks so the deadline is never missed.
+Input: 		- bus: Pointer to the I²C bus (unused)
+			- deadline_us: esp_timer time to wait for
+Returns:	None
+ ============================================================================*/
+static void _i2c_sleep_until(bmx20_bus_t *bus, int64_t deadline_us)
+{
+    int64_t left = deadline_us - esp_timer_get_time();
+    if (left > 0) {
+        vTaskDelay(pdMS_TO_TICKS((left + 999) / 1000) + 1);
+    }
+}// eo _i2c_sleep_until::
+
+/*>>> bmx20_i2c_open: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will set up the I²C bus on an installed port.
+Input: 		- io: Pointer to the I²C bus
+			- port: I2C port number
+Returns:	None
+ ============================================================================*/
+void bmx20_i2c_open(bmx20_i2c_t *io, i2c_port_t port)
+{
+    io->base.xfer        = _i2c_xfer;
+    io->base.now_us      = _i2c_now_us;
+    io->base.sleep_until = _i2c_sleep_until;
+    io->port             = port;
+}// eo bmx20_i2c_open::
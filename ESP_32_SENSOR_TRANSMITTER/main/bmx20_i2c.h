@@ -0,0 +1,34 @@
+/*===================================================================================================
+File Name:	bmx20_i2c.h
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the interface for the I²C bus of the BMX-20 driver, which
+talks to the sensors (or the mux in front of them) through the legacy ESP-IDF I²C driver.
+Command links are built in a buffer owned by the bus, so transfers never touch the heap; the
+buffer is reused by every transfer, so one bus must only be used from one task.
+===================================================================================================*/
+#ifndef BMX20_I2C_H
+#define BMX20_I2C_H
+
+#include "driver/i2c.h"
+#include "bmx20_bus.h"
+
+#define BMX20_I2C_TIMEOUT_MS  100 // Per-transaction timeout
+#define BMX20_I2C_LINK_SIZE   I2C_LINK_RECOMMENDED_SIZE(2) // write + repeated-start read
+
+typedef struct {
+    bmx20_bus_t base;   // must be first
+    i2c_port_t  port;   // installed by the application
+    uint8_t     link[BMX20_I2C_LINK_SIZE]; // command-link storage, reused per transfer
+} bmx20_i2c_t; // Legacy I²C bus
+
+/**
+ * @brief Set up `io` as a bus on `port`. The port must already be configured
+ *        and installed with i2c_param_config()/i2c_driver_install().
+ */
+void bmx20_i2c_open(bmx20_i2c_t *io, i2c_port_t port);
+
+#endif // BMX20_I2C_H
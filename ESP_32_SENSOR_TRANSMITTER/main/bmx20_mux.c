@@ -0,0 +1,110 @@
+/*=============================================================================
+	File Name:	bmx20_mux.c
+	Author:		Vraj Patel, Samip Patel
+	Date:		17/10/2026
+	Modified:	None
+	© Fanshawe College, 2025
+
+	Description: This file contains the TCA9548A channel buses. The mux keeps the channel
+    it last switched in, so back-to-back transfers to the same sensor pair cost no
+    extra select write.
+=============================================================================*/
+
+#include "bmx20_mux.h"
+
+/*>>> _mux_xfer: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will switch the mux to this channel if needed and forward
+			the transfer to the parent bus. A failed select leaves the selection
+			unknown so the next transfer writes it again.
+Input: 		- bus: Pointer to the channel bus
+			- addr / wr / wr_len / rd / rd_len: As bmx20_bus_t::xfer
+Returns:	ESP_OK on success, or an error code on failure.
+ ============================================================================*/
+static esp_err_t _mux_xfer(bmx20_bus_t *bus, uint8_t addr,
+                           const uint8_t *wr, size_t wr_len, uint8_t *rd, size_t rd_len)
+{
+    bmx20_mux_channel_t *ch  = (bmx20_mux_channel_t *)bus;
+    bmx20_mux_t         *mux = ch->mux;
+    if (mux->selected != ch->channel) {
+        uint8_t mask = 1u << ch->channel;
+        esp_err_t err = mux->parent->xfer(mux->parent, mux->addr, &mask, 1, NULL, 0);
+        if (err) {
+            mux->selected = -1;
+            return err;
+        }
+        mux->selected = ch->channel;
+    }
+    return mux->parent->xfer(mux->parent, addr, wr, wr_len, rd, rd_len);
+}// eo _mux_xfer::
+
+/*>>> _mux_now_us: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will return the parent bus's time.
+Input: 		- bus: Pointer to the channel bus
+Returns:	Time in µs.
+ ============================================================================*/
+static int64_t _mux_now_us(bmx20_bus_t *bus)
+{
+    bmx20_bus_t *parent = ((bmx20_mux_channel_t *)bus)->mux->parent;
+    return parent->now_us(parent);
+}// eo _mux_now_us::
+
+/*>>> _mux_sleep_until: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will wait on the parent bus's clock.
+Input: 		- bus: Pointer to the channel bus
+			- deadline_us: Time to wait for
+Returns:	None
+ ============================================================================*/
+static void _mux_sleep_until(bmx20_bus_t *bus, int64_t deadline_us)
+{
+    bmx20_bus_t *parent = ((bmx20_mux_channel_t *)bus)->mux->parent;
+    parent->sleep_until(parent, deadline_us);
+}// eo _mux_sleep_until::
+
+/*>>> bmx20_mux_init: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will describe a mux; its selection starts unknown.
+Input: 		- mux: Pointer to the mux
+			- parent: Bus the mux is on
+			- addr: Mux address
+Returns:	None
+ ============================================================================*/
+void bmx20_mux_init(bmx20_mux_t *mux, bmx20_bus_t *parent, uint8_t addr)
+{
+    mux->parent   = parent;
+    mux->addr     = addr;
+    mux->selected = -1;
+}// eo bmx20_mux_init::
+
+/*>>> bmx20_mux_channel_init: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will set up the bus behind one mux channel.
+Input: 		- ch: Pointer to the channel bus
+			- mux: Pointer to the mux
+			- channel: 0..BMX20_MUX_CHANNELS-1
+Returns:	ESP_OK, or ESP_ERR_INVALID_ARG for a channel the mux does not have.
+ ============================================================================*/
+esp_err_t bmx20_mux_channel_init(bmx20_mux_channel_t *ch, bmx20_mux_t *mux, uint8_t channel)
+{
+    if (channel >= BMX20_MUX_CHANNELS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    ch->base.xfer        = _mux_xfer;
+    ch->base.now_us      = _mux_now_us;
+    ch->base.sleep_until = _mux_sleep_until;
+    ch->mux              = mux;
+    ch->channel          = channel;
+    return ESP_OK;
+}// eo bmx20_mux_channel_init::
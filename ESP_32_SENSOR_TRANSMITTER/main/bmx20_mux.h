@@ -0,0 +1,45 @@
+/*===================================================================================================
+File Name:	bmx20_mux.h
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the interface for TCA9548A-style I²C multiplexers. Every AHT20 /
+BMP280 pair answers at the same addresses, so each pair sits on its own mux channel and gets its
+own bus: a channel bus selects its channel (only when another one is selected) and forwards the
+transfer to the bus the mux is on.
+===================================================================================================*/
+#ifndef BMX20_MUX_H
+#define BMX20_MUX_H
+
+#include <stdint.h>
+#include "bmx20_bus.h"
+
+#define BMX20_MUX_ADDR      0x70 // TCA9548A with A2..A0 low
+#define BMX20_MUX_CHANNELS  8
+
+typedef struct {
+    bmx20_bus_t *parent;   // bus the mux is on
+    uint8_t      addr;     // mux address
+    int8_t       selected; // channel currently switched in, -1 = unknown
+} bmx20_mux_t; // One TCA9548A
+
+typedef struct {
+    bmx20_bus_t  base;     // must be first
+    bmx20_mux_t *mux;
+    uint8_t      channel;
+} bmx20_mux_channel_t; // Bus behind one mux channel
+
+/**
+ * @brief Describe the mux at `addr` on `parent`. No bus traffic.
+ */
+void bmx20_mux_init(bmx20_mux_t *mux, bmx20_bus_t *parent, uint8_t addr);
+
+/**
+ * @brief Set up `ch` as the bus behind `channel` of `mux`.
+ * @return ESP_ERR_INVALID_ARG if the channel does not exist
+ */
+esp_err_t bmx20_mux_channel_init(bmx20_mux_channel_t *ch, bmx20_mux_t *mux, uint8_t channel);
+
+#endif // BMX20_MUX_H
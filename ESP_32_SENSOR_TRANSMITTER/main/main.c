@@ -2,7 +2,7 @@
 File Name:	main.c
 Author:		Vraj Patel
 Date:		17/07/2025
-Modified:	None
+Modified:	17/10/2026
 © Fanshawe College, 2025
 
 Description: This file contains the main application logic for the Smart shelf Inventory Management project for its Secondary Controller,
@@ -18,6 +18,9 @@ including initialization, task management, and event handling.
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <stdio.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <sys/select.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -27,6 +30,7 @@ including initialization, task management, and event handling.
 #include "esp_netif.h"
 #include "esp_event.h"
 #include "esp_wifi.h"
+#include "esp_timer.h"
 #include "lwip/sockets.h"
 
 // I2C + GPIO for sensors
@@ -35,6 +39,7 @@ including initialization, task management, and event handling.
 
 // your sensor abstraction (IR, spill, BMX20)
 #include "sensors.h"
+#include "sensor_frame.h"
 
 static const char *TAG       = "SECONDARY"; // Tag for logging
 static const char *TAG_WIFI  = "WIFI"; // Tag for Wi-Fi events
@@ -43,6 +48,46 @@ static const char *TAG_WIFI  = "WIFI"; // Tag for Wi-Fi events
 #define AP_PASS       "test1234"    // Access Point Password
 #define PRIMARY_IP    "192.168.4.1"  // Primary Controller IP
 #define PRIMARY_PORT  3333           // Primary Controller port
+#define SEND_BINARY   1              // 1 = binary sensor frame, 0 = CSV for older primaries
+#define SEND_DELTAS   1              // 1 = occupancy edges as delta frames + periodic snapshots
+#if SEND_DELTAS
+#define SAMPLE_PERIOD_MS     5000    // Resync snapshot (occupancy, spill, T/H)
+#else
+#define SAMPLE_PERIOD_MS     1000    // One full sensor frame per second
+#define ENV_POLL_MS          10      // Humidity conversion poll period
+#endif
+
+#if SEND_DELTAS && !SEND_BINARY
+#error "SEND_DELTAS needs the binary frame format"
+#endif
+
+// Link to the Primary: one long-lived TCP connection
+#define LINK_CONNECT_TIMEOUT_MS  3000  // Give up on a pending connect() after this long
+#define LINK_BACKOFF_MIN_MS      500   // First reconnect delay
+#define LINK_BACKOFF_MAX_MS      30000 // Reconnect delay cap (doubles per failure)
+#define LINK_KEEPIDLE_S          5     // Idle time before the first keepalive probe
+#define LINK_KEEPINTVL_S         2     // Between probes
+#define LINK_KEEPCNT             3     // Unanswered probes before the link is dropped
+
+typedef enum {
+    LINK_DOWN,        // waiting for the next reconnect attempt
+    LINK_CONNECTING,  // non-blocking connect() in progress
+    LINK_UP,          // frames are streamed
+} link_state_t;
+
+typedef struct {
+    int          fd;          // socket, -1 when down
+    link_state_t state;
+    TickType_t   deadline;    // connect timeout (CONNECTING) or next attempt (DOWN)
+    uint32_t     backoff_ms;  // delay after the next failure
+    uint32_t     connects;    // successful connects
+    uint32_t     failures;    // failed connects and dropped links
+    uint32_t     skipped;     // samples not sent because the link was down or congested
+    bool         resync;      // link (re)established: send a snapshot now
+} link_t; // Connection to the Primary
+
+static link_t s_link = { .fd = -1, .state = LINK_DOWN, .backoff_ms = LINK_BACKOFF_MIN_MS };
+static uint16_t s_seq;  // frame sequence number, shared by snapshots and deltas
 
 // — Wi‑Fi Station setup —  
 
@@ -80,62 +125,372 @@ static void wifi_init_sta(void)
     ESP_ERROR_CHECK(esp_wifi_connect());
 }// eo wifi_init_sta::
 
-// — Send task: read sensors, send CSV over TCP —  
-/*>>> send_task: ======================================================================
+// — Message encoding —  
+/*>>> build_message: ======================================================================
 Author: Vraj Patel
 Date: 17/07/2025
-Modified: 27/07/2025
-Desc: Task to read sensor data and send it over TCP.
-Input: void *arg - Task argument (unused).
+Modified: 17/10/2026
+Desc: Encode one sample as a binary sensor frame, or as the legacy CSV line when SEND_BINARY is 0.
+Input: const sensor_data_t *d - Sample.
+       uint8_t *msg - Output buffer.
+       size_t size - Size of msg.
+Return: int - Number of bytes to send.
+=========================================================================================================*/
+static int build_message(const sensor_data_t *d, uint8_t *msg, size_t size)
+{
+#if SEND_BINARY
+    sensor_frame_t f = {
+        .seq    = s_seq++,
+        .spill  = d->spill,
+        .temp_c = sensor_frame_centi(d->temperature),
+        .hum_c  = sensor_frame_centi(d->humidity),
+    };
+    for (int i = 0; i < PROX_COUNT; i++) {
+        if (d->prox[i]) f.occupancy |= 1u << i;
+    }
+    sensor_frame_encode(&f, msg);
+    return SENSOR_FRAME_LEN;
+#else
+    // CSV: P0..P9,SPILL,TEMP,HUM\n
+    char *out = (char *)msg;
+    int off = 0;
+    for (int i = 0; i < PROX_COUNT; i++) {
+        off += snprintf(out + off, size - off, "%d,", d->prox[i] ? 1 : 0);
+    }
+    off += snprintf(out + off, size - off, "%d,", d->spill ? 1 : 0);
+    off += snprintf(out + off, size - off, "%.2f,%.2f\n",
+                    d->temperature, d->humidity);
+    return off;
+#endif
+}// eo build_message::
+
+// — Link to the Primary —  
+/*>>> tick_reached: ======================================================================
+Author: Vraj Patel
+Date: 17/10/2026
+Modified: None
+Desc: Wrap-safe check whether a tick deadline has passed.
+Input: TickType_t t - Deadline.
+Return: bool - true once the tick count has reached t.
+=========================================================================================================*/
+static bool tick_reached(TickType_t t)
+{
+    return (int32_t)(xTaskGetTickCount() - t) >= 0;
+}// eo tick_reached::
+
+/*>>> link_fail: ======================================================================
+Author: Vraj Patel
+Date: 17/10/2026
+Modified: None
+Desc: Drop the socket and schedule the next connect attempt with exponential backoff.
+Input: const char *why - Reason for the log.
 Return: None
 =========================================================================================================*/
-static void send_task(void *arg)
+static void link_fail(const char *why)
+{
+    if (s_link.fd >= 0) {
+        close(s_link.fd);
+        s_link.fd = -1;
+    }
+    s_link.failures++;
+    s_link.state    = LINK_DOWN;
+    s_link.deadline = xTaskGetTickCount() + pdMS_TO_TICKS(s_link.backoff_ms);
+    ESP_LOGW(TAG, "Link down (%s, errno %d), retry in %lu ms", why, errno, (unsigned long)s_link.backoff_ms);
+    s_link.backoff_ms = (s_link.backoff_ms * 2 > LINK_BACKOFF_MAX_MS) ? LINK_BACKOFF_MAX_MS : s_link.backoff_ms * 2;
+}// eo link_fail::
+
+/*>>> link_up: ======================================================================
+Author: Vraj Patel
+Date: 17/10/2026
+Modified: None
+Desc: Connection established: start streaming and reset the backoff.
+Input: None
+Return: None
+=========================================================================================================*/
+static void link_up(void)
+{
+    s_link.state      = LINK_UP;
+    s_link.backoff_ms = LINK_BACKOFF_MIN_MS;
+    s_link.resync     = true;
+    s_link.connects++;
+    ESP_LOGI(TAG, "Link up to %s:%d", PRIMARY_IP, PRIMARY_PORT);
+}// eo link_up::
+
+/*>>> link_start_connect: ======================================================================
+Author: Vraj Patel
+Date: 17/10/2026
+Modified: None
+Desc: Open a non-blocking socket with keepalive and start connecting to the Primary.
+Input: None
+Return: None
+=========================================================================================================*/
+static void link_start_connect(void)
 {
-    sensor_data_t d;
-    char msg[128];
     struct sockaddr_in dest = {
         .sin_family      = AF_INET,
         .sin_port        = htons(PRIMARY_PORT),
         .sin_addr.s_addr = inet_addr(PRIMARY_IP)
     };
 
-    for (;;) {
-        // 1) Sample all sensors
-        if (sensors_read(&d) != ESP_OK) {
-            ESP_LOGW(TAG, "sensors_read() failed");
-            vTaskDelay(pdMS_TO_TICKS(1000));
+    s_link.fd = socket(AF_INET, SOCK_STREAM, IPPROTO_IP);
+    if (s_link.fd < 0) {
+        link_fail("socket");
+        return;
+    }
+    int one = 1, idle = LINK_KEEPIDLE_S, intvl = LINK_KEEPINTVL_S, cnt = LINK_KEEPCNT;
+    setsockopt(s_link.fd, SOL_SOCKET,  SO_KEEPALIVE,  &one,   sizeof(one));
+    setsockopt(s_link.fd, IPPROTO_TCP, TCP_KEEPIDLE,  &idle,  sizeof(idle));
+    setsockopt(s_link.fd, IPPROTO_TCP, TCP_KEEPINTVL, &intvl, sizeof(intvl));
+    setsockopt(s_link.fd, IPPROTO_TCP, TCP_KEEPCNT,   &cnt,   sizeof(cnt));
+    setsockopt(s_link.fd, IPPROTO_TCP, TCP_NODELAY,   &one,   sizeof(one)); // frames are tiny
+    fcntl(s_link.fd, F_SETFL, fcntl(s_link.fd, F_GETFL, 0) | O_NONBLOCK);
+
+    if (connect(s_link.fd, (struct sockaddr*)&dest, sizeof(dest)) == 0) {
+        link_up();
+    } else if (errno == EINPROGRESS) {
+        s_link.state    = LINK_CONNECTING;
+        s_link.deadline = xTaskGetTickCount() + pdMS_TO_TICKS(LINK_CONNECT_TIMEOUT_MS);
+    } else {
+        link_fail("connect");
+    }
+}// eo link_start_connect::
+
+/*>>> link_wait: ======================================================================
+Author: Vraj Patel
+Date: 17/10/2026
+Modified: None
+Desc: Sleep until `until` while driving the link: start reconnects when the backoff has elapsed,
+      finish pending connects, and notice a connection closed by the Primary. The sampling
+      schedule is never held up by the network.
+Input: TickType_t until - Tick of the next sample.
+Return: None
+=========================================================================================================*/
+static void link_wait(TickType_t until)
+{
+    while (!tick_reached(until)) {
+        if (s_link.state == LINK_DOWN && tick_reached(s_link.deadline)) {
+            link_start_connect();
+            continue;
+        }
+        if (s_link.state == LINK_CONNECTING && tick_reached(s_link.deadline)) {
+            errno = ETIMEDOUT;
+            link_fail("connect timeout");
             continue;
         }
 
-        // 2) Build CSV: P0..P9,SPILL,TEMP,HUM\n
-        int off = 0;
-        for (int i = 0; i < PROX_COUNT; i++) {
-            off += snprintf(msg + off, sizeof(msg) - off, "%d,", d.prox[i] ? 1 : 0);
+        TickType_t now  = xTaskGetTickCount();
+        TickType_t wake = until;
+        if (s_link.state != LINK_UP && (int32_t)(s_link.deadline - until) < 0) {
+            wake = s_link.deadline; // connect timeout or retry comes first
+        }
+        if (s_link.state == LINK_DOWN) {
+            vTaskDelay(wake - now);
+            continue;
         }
-        off += snprintf(msg + off, sizeof(msg) - off, "%d,", d.spill ? 1 : 0);
-        off += snprintf(msg + off, sizeof(msg) - off, "%.2f,%.2f\n",
-                        d.temperature, d.humidity);
-
-        // 3) Open socket, connect, send
-        int sock = socket(AF_INET, SOCK_STREAM, IPPROTO_IP);
-        if (sock < 0) {
-            ESP_LOGE(TAG, "socket() errno %d", errno);
-        } else if (connect(sock, (struct sockaddr*)&dest, sizeof(dest)) != 0) {
-            ESP_LOGE(TAG, "connect() errno %d", errno);
-        } else {
-            int len = strlen(msg);
-            if (write(sock, msg, len) != len) {
-                ESP_LOGE(TAG, "send() errno %d", errno);
-            } else {
-                ESP_LOGI(TAG, "Sent: %s", msg);
+
+        // CONNECTING: wait for writable; UP: wait for readable (EOF/reset from the Primary)
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(s_link.fd, &fds);
+        uint32_t ms = (wake - now) * portTICK_PERIOD_MS;
+        struct timeval tv = { .tv_sec = ms / 1000, .tv_usec = (ms % 1000) * 1000 };
+        int n = (s_link.state == LINK_CONNECTING) ? select(s_link.fd + 1, NULL, &fds, NULL, &tv)
+                                                  : select(s_link.fd + 1, &fds, NULL, NULL, &tv);
+        if (n < 0) {
+            link_fail("select");
+        } else if (s_link.state == LINK_CONNECTING) {
+            if (n > 0) {
+                int err = 0;
+                socklen_t elen = sizeof(err);
+                getsockopt(s_link.fd, SOL_SOCKET, SO_ERROR, &err, &elen);
+                if (err == 0) {
+                    link_up();
+                } else {
+                    errno = err;
+                    link_fail("connect");
+                }
+            }
+        } else if (n > 0) {
+            char buf[16];
+            int r = recv(s_link.fd, buf, sizeof(buf), MSG_DONTWAIT); // Primary never sends
+            if (r == 0) {
+                errno = 0;
+                link_fail("closed by Primary");
+            } else if (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                link_fail("recv");
             }
         }
-        if (sock >= 0) {
-            shutdown(sock, 0);
-            close(sock);
+    }
+}// eo link_wait::
+
+/*>>> link_send: ======================================================================
+Author: Vraj Patel
+Date: 17/10/2026
+Modified: None
+Desc: Stream one message without blocking. The sample is skipped if the link is down or its send
+      buffer is full; a partial write would break framing, so it drops the link.
+Input: const void *msg - Message.
+       int len - Length of msg.
+Return: bool - true if the whole message was queued.
+=========================================================================================================*/
+static bool link_send(const void *msg, int len)
+{
+    if (s_link.state != LINK_UP) {
+        s_link.skipped++;
+        return false;
+    }
+    int n = send(s_link.fd, msg, len, MSG_DONTWAIT);
+    if (n == len) {
+        return true;
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        s_link.skipped++;
+        ESP_LOGW(TAG, "Link congested, sample skipped");
+    } else {
+        link_fail(n < 0 ? "send" : "short send");
+    }
+    return false;
+}// eo link_send::
+
+// — Send task —  
+/*>>> send_snapshot: ======================================================================
+Author: Vraj Patel
+Date: 17/07/2025
+Modified: 17/10/2026
+Desc: Stream one full frame of a completed sensor sample.
+Input: sensor_data_t *d - Sample from sensors_read().
+       uint16_t occ - Debounced occupancy (used instead of a raw IR read when deltas are on).
+Return: bool - true if the frame went out.
+=========================================================================================================*/
+static bool send_snapshot(sensor_data_t *d, uint16_t occ)
+{
+    uint8_t msg[128];
+
+#if SEND_DELTAS
+    // keep snapshots consistent with the deltas already sent
+    for (int i = 0; i < PROX_COUNT; i++) {
+        d->prox[i] = (occ >> i) & 1;
+    }
+#endif
+
+    int len = build_message(d, msg, sizeof(msg));
+    bool sent = link_send(msg, len);
+    if (sent) {
+        ESP_LOGI(TAG, "Sent %d bytes (T=%.2f H=%.2f)", len, d->temperature, d->humidity);
+    }
+    // the frame carries the first climate point; the others are logged
+    for (int i = 1; i < d->env_count; i++) {
+        if (d->env[i].err == ESP_OK) {
+            ESP_LOGI(TAG, "Climate #%d: T=%.2f H=%.2f", i, d->env[i].temperature, d->env[i].humidity);
         }
+    }
+    return sent;
+}// eo send_snapshot::
 
-        vTaskDelay(pdMS_TO_TICKS(1000));
+#define DELTA_BATCH  16 // Delta frames coalesced into one send
+
+typedef struct {
+    uint8_t msg[DELTA_BATCH * SENSOR_DELTA_LEN];
+    int     len;
+} delta_batch_t; // Delta frames of one poll
+
+/*>>> flush_deltas: ======================================================================
+Author: Vraj Patel
+Date: 17/10/2026
+Modified: None
+Desc: Stream the batched delta frames in a single send.
+Input: delta_batch_t *b - Batch.
+Return: None
+=========================================================================================================*/
+static void flush_deltas(delta_batch_t *b)
+{
+    if (b->len && link_send(b->msg, b->len)) {
+        ESP_LOGI(TAG, "Sent %d delta(s)", b->len / SENSOR_DELTA_LEN);
+    }
+    b->len = 0;
+}// eo flush_deltas::
+
+/*>>> on_occ_change: ======================================================================
+Author: Vraj Patel
+Date: 17/10/2026
+Modified: None
+Desc: sensors_poll_occupancy() callback: encode the change as a delta frame.
+Input: const occ_change_t *c - Change.
+       void *ctx - delta_batch_t.
+Return: None
+=========================================================================================================*/
+static void on_occ_change(const occ_change_t *c, void *ctx)
+{
+    delta_batch_t *b = ctx;
+    sensor_delta_t d = { .seq = s_seq++, .slot = c->slot, .occupied = c->occupied };
+    sensor_delta_encode(&d, b->msg + b->len);
+    b->len += SENSOR_DELTA_LEN;
+    ESP_LOGI(TAG, "Slot %u %s (edge %lld us ago)", c->slot, c->occupied ? "placed" : "picked",
+             (long long)(esp_timer_get_time() - c->time_us));
+    if (b->len == sizeof(b->msg)) {
+        flush_deltas(b);
+    }
+}// eo on_occ_change::
+
+/*>>> send_task: ======================================================================
+Author: Vraj Patel
+Date: 17/07/2025
+Modified: 17/10/2026
+Desc: Stream sensor frames over the long-lived link to the Primary. With SEND_DELTAS the IR edges
+      captured by interrupt are drained every OCC_POLL_MS and each occupancy change goes out at
+      once as a delta frame; full
+      snapshots are sent every SAMPLE_PERIOD_MS and whenever the link comes up, so a lost delta is
+      repaired. A snapshot starts the T/H conversion and is sent once it has been collected,
+      so the ~80 ms conversion never blocks the task. A failed T/H read still sends the
+      occupancy (with the last good T/H), and a resync only ends once a snapshot has gone out.
+      Between polls the task services the link.
+Input: void *arg - Task argument (unused).
+Return: None
+=========================================================================================================*/
+static void send_task(void *arg)
+{
+    uint16_t   occ = 0;
+    bool       env_pending = false; // T/H conversion in flight
+    TickType_t next_snapshot = xTaskGetTickCount();
+#if SEND_DELTAS
+    TickType_t next_poll = next_snapshot;
+#endif
+
+    for (;;) {
+#if SEND_DELTAS
+        delta_batch_t batch = { .len = 0 };
+        sensors_poll_occupancy(s_link.resync ? NULL : on_occ_change, &batch, &occ);
+        flush_deltas(&batch);
+#endif
+        if (!env_pending && (tick_reached(next_snapshot) || s_link.resync)) {
+            next_snapshot = xTaskGetTickCount() + pdMS_TO_TICKS(SAMPLE_PERIOD_MS);
+            // a failed trigger is reported by sensors_read(), which then returns at once
+            sensors_env_trigger();
+            env_pending = true;
+        }
+        if (env_pending) {
+            sensor_data_t d;
+            esp_err_t err = sensors_read(&d);
+            if (err != ESP_ERR_NOT_FINISHED) {
+                env_pending = false;
+                if (err != ESP_OK) {
+                    ESP_LOGW(TAG, "sensors_read() failed, sending occupancy with the last T/H");
+                }
+                if (send_snapshot(&d, occ)) {
+                    s_link.resync = false; // deltas resume once the snapshot is out
+                }
+            }
+        }
+
+#if SEND_DELTAS
+        next_poll += pdMS_TO_TICKS(OCC_POLL_MS);
+        if (tick_reached(next_poll)) {
+            next_poll = xTaskGetTickCount(); // fell behind (e.g. slow sensor read): don't burst
+        }
+        link_wait(next_poll);
+#else
+        link_wait(env_pending ? xTaskGetTickCount() + pdMS_TO_TICKS(ENV_POLL_MS) : next_snapshot);
+#endif
     }
 }// eo send_task::
 
@@ -0,0 +1,160 @@
+/*======================================================================================================
+File Name:	sensor_frame.c
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the encoders and decoders for the binary snapshot and delta
+frames. The same file is kept in both projects and must stay identical.
+====================================================================================================*/
+
+#include "sensor_frame.h"
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), one nibble per lookup
+static const uint16_t s_crc_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+/*>>> crc16: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: CRC-16/CCITT-FALSE over a buffer.
+Input: const uint8_t *p - Data.
+       size_t n - Number of bytes.
+Return: uint16_t - CRC.
+=========================================================================================================*/
+static uint16_t crc16(const uint8_t *p, size_t n)
+{
+    uint16_t crc = 0xFFFF;
+    while (n--)
+    {
+        crc = (crc << 4) ^ s_crc_nibble[(crc >> 12) ^ (*p >> 4)];
+        crc = (crc << 4) ^ s_crc_nibble[(crc >> 12) ^ (*p & 0x0F)];
+        p++;
+    }
+    return crc;
+} // eo crc16::
+
+/*>>> put16 / get16: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Little-endian 16-bit store/load, independent of host byte order and alignment.
+=========================================================================================================*/
+static inline void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline uint16_t get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+} // eo put16 / get16::
+
+/*>>> sensor_frame_centi: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Scale a reading to 0.01 units, rounding half away from zero and clamping to int16.
+Input: float v - Reading.
+Return: int16_t - v × 100.
+=========================================================================================================*/
+int16_t sensor_frame_centi(float v)
+{
+    float c = v * 100.0f + (v < 0 ? -0.5f : 0.5f);
+    if (c >  32767.0f) return  32767;
+    if (c < -32768.0f) return -32768;
+    return (int16_t)c;
+} // eo sensor_frame_centi::
+
+/*>>> sensor_frame_encode: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Lay a sample out in wire order and append its CRC.
+Input: const sensor_frame_t *f - Sample.
+       uint8_t out[] - SENSOR_FRAME_LEN bytes.
+Return: None
+=========================================================================================================*/
+void sensor_frame_encode(const sensor_frame_t *f, uint8_t out[SENSOR_FRAME_LEN])
+{
+    out[0] = SENSOR_FRAME_SYNC;
+    out[1] = SENSOR_FRAME_VERSION;
+    put16(out + 2, f->seq);
+    put16(out + 4, f->occupancy);
+    out[6] = f->spill ? SENSOR_FRAME_SPILL : 0;
+    put16(out + 7, (uint16_t)f->temp_c);
+    put16(out + 9, (uint16_t)f->hum_c);
+    put16(out + 11, crc16(out, 11));
+} // eo sensor_frame_encode::
+
+/*>>> sensor_frame_decode: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Validate length, sync, version and CRC, then unpack the fields.
+Input: const uint8_t *buf - Received frame.
+       size_t len - Number of bytes.
+       sensor_frame_t *out - Decoded sample (only written on SENSOR_FRAME_OK).
+Return: sensor_frame_err_t - SENSOR_FRAME_OK or the first check that failed.
+=========================================================================================================*/
+sensor_frame_err_t sensor_frame_decode(const uint8_t *buf, size_t len, sensor_frame_t *out)
+{
+    if (len != SENSOR_FRAME_LEN)              return SENSOR_FRAME_ERR_LEN;
+    if (buf[0] != SENSOR_FRAME_SYNC)          return SENSOR_FRAME_ERR_SYNC;
+    if (buf[1] != SENSOR_FRAME_VERSION)       return SENSOR_FRAME_ERR_VERSION;
+    if (get16(buf + 11) != crc16(buf, 11))    return SENSOR_FRAME_ERR_CRC;
+
+    out->seq       = get16(buf + 2);
+    out->occupancy = get16(buf + 4);
+    out->spill     = (buf[6] & SENSOR_FRAME_SPILL) != 0;
+    out->temp_c    = (int16_t)get16(buf + 7);
+    out->hum_c     = (int16_t)get16(buf + 9);
+    return SENSOR_FRAME_OK;
+} // eo sensor_frame_decode::
+
+/*>>> sensor_delta_encode: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Lay an occupancy change out in wire order and append its CRC.
+Input: const sensor_delta_t *d - Change.
+       uint8_t out[] - SENSOR_DELTA_LEN bytes.
+Return: None
+=========================================================================================================*/
+void sensor_delta_encode(const sensor_delta_t *d, uint8_t out[SENSOR_DELTA_LEN])
+{
+    out[0] = SENSOR_DELTA_SYNC;
+    out[1] = SENSOR_FRAME_VERSION;
+    put16(out + 2, d->seq);
+    out[4] = d->slot;
+    out[5] = d->occupied ? 1 : 0;
+    put16(out + 6, crc16(out, 6));
+} // eo sensor_delta_encode::
+
+/*>>> sensor_delta_decode: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Validate length, sync, version and CRC, then unpack the change.
+Input: const uint8_t *buf - Received frame.
+       size_t len - Number of bytes.
+       sensor_delta_t *out - Decoded change (only written on SENSOR_FRAME_OK).
+Return: sensor_frame_err_t - SENSOR_FRAME_OK or the first check that failed.
+=========================================================================================================*/
+sensor_frame_err_t sensor_delta_decode(const uint8_t *buf, size_t len, sensor_delta_t *out)
+{
+    if (len != SENSOR_DELTA_LEN)              return SENSOR_FRAME_ERR_LEN;
+    if (buf[0] != SENSOR_DELTA_SYNC)          return SENSOR_FRAME_ERR_SYNC;
+    if (buf[1] != SENSOR_FRAME_VERSION)       return SENSOR_FRAME_ERR_VERSION;
+    if (get16(buf + 6) != crc16(buf, 6))      return SENSOR_FRAME_ERR_CRC;
+
+    out->seq      = get16(buf + 2);
+    out->slot     = buf[4];
+    out->occupied = buf[5] != 0;
+    return SENSOR_FRAME_OK;
+} // eo sensor_delta_decode::
@@ -2,18 +2,28 @@
 File Name:	sensors.c
 Author:		Vraj Patel, Samip Patel, Mihir Jariwala, Vamseedhar Reddy
 Date:		10/07/2025
-Modified:	02/08/2025
+Modified:	17/10/2026
 © Fanshawe College, 2025
 
 Description: This file contains the implementation of the sensor management functions,
-including initialization, configuration, and data reading for the BMX-20 sensor.
+including initialization, configuration, and data reading for the BMX-20 sensor. IR occupancy is
+captured by any-edge GPIO interrupts: the ISR timestamps each edge and pushes it into a
+single-producer/single-consumer ring that the acquisition task drains without locks. The IR bank
+is handled as one 64-bit pin mask: it is configured with a single gpio_config() and sampled with
+one read of the GPIO input registers, packed into a slot bitmask by a byte-wise gather table.
 ===================================================================================================*/
 
 
 #include "sensors.h"
 #include "BMX_20.h"
+#include "bmx20_i2c.h"
+#include "bmx20_mux.h"
 #include "esp_log.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
 #include "driver/gpio.h"
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
 
 static const char *TAG = "SENSORS";
 
@@ -25,12 +35,115 @@ static const gpio_num_t ir_gpio[SHELF_SLOTS] = {
     GPIO_NUM_25                              // large+liquid
 };
 
-static bmx20_t s_bmx20_dev;
+// Climate points: TCA9548A channel of each AHT20 + BMP280 pair, or ENV_NO_MUX for a single
+// pair on the bus itself (e.g. { 0, 1, 2, 3 } for four cold-storage bays)
+static const int8_t s_env_channel[] = { ENV_NO_MUX };
+#define ENV_POINTS  (sizeof(s_env_channel) / sizeof(s_env_channel[0]))
+_Static_assert(ENV_POINTS <= ENV_POINTS_MAX, "too many climate points");
+
+static bmx20_i2c_t         s_i2c;                   // bus on I2C_NUM_0
+static bmx20_mux_t         s_env_mux;
+static bmx20_mux_channel_t s_env_bus[ENV_POINTS];   // one bus per muxed pair
+static bmx20_t             s_env_dev[ENV_POINTS];
+static bmx20_t            *s_env_devp[ENV_POINTS];
+static env_reading_t       s_env_last[ENV_POINTS];  // results of the current conversion
+static bool                s_env_triggered;         // sensors_env_trigger() awaiting collection
+static float               s_env_good_t, s_env_good_h; // last primary reading that was read OK
+
+// IR bank sampling: input registers → slot bitmask, one table lookup per byte lane in use
+#define IR_GATHER_LANES  3  // Byte lanes of the 40 GPIOs the IR pins may span
+static uint64_t s_ir_pins;                           // pin mask of the IR bank
+static uint8_t  s_gather_shift[IR_GATHER_LANES];     // bit offset of each lane in the input word
+static uint16_t s_gather[IR_GATHER_LANES][256];      // lane byte → slot bits
+static uint8_t  s_gather_lanes;                      // lanes in use
+
+// IR edge ring: written only by _ir_isr, read only by sensors_poll_occupancy
+typedef struct {
+    int64_t time_us;
+    uint8_t slot;
+    bool    level;
+} ir_edge_t;
+
+static ir_edge_t         s_ring[IR_EDGE_RING_LEN];
+static volatile uint32_t s_ring_head;     // next write (ISR)
+static volatile uint32_t s_ring_tail;     // next read (task)
+static volatile bool     s_ring_overrun;  // edges were lost since the last drain
+static uint32_t          s_overruns;
+
+// Debounce state per slot (task only)
+#define OCC_ALL  ((1u << SHELF_SLOTS) - 1)
+static uint16_t s_occ_stable;                 // reported occupancy
+static uint16_t s_pend_level;                 // level after the latest edge
+static uint16_t s_pend_valid;                 // slot has an edge not yet settled
+static int64_t  s_pend_time[SHELF_SLOTS];     // time of that edge
+
+static void _ir_isr(void *arg);
+
+/*>>> _build_ir_gather: ==========================================================
+Author:		Vraj Patel, Samip Patel, Mihir Jariwala, Vamseedhar Reddy
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will build the IR pin mask and, for every byte lane of the GPIO
+			input word that holds IR pins, a table from that byte to the slot bits it carries.
+Input: 		None
+Returns:	ESP_OK, or ESP_ERR_INVALID_ARG if the pins span more than IR_GATHER_LANES bytes.
+ ============================================================================*/
+static esp_err_t _build_ir_gather(void)
+{
+    s_ir_pins = 0;
+    for (int i = 0; i < SHELF_SLOTS; i++) {
+        s_ir_pins |= 1ULL << ir_gpio[i];
+    }
+    s_gather_lanes = 0;
+    for (int lane = 0; lane < 8; lane++) {
+        if (!((s_ir_pins >> (lane * 8)) & 0xFF)) {
+            continue;
+        }
+        if (s_gather_lanes == IR_GATHER_LANES) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        uint16_t *t = s_gather[s_gather_lanes];
+        for (int b = 0; b < 256; b++) {
+            t[b] = 0;
+            for (int i = 0; i < SHELF_SLOTS; i++) {
+                int bit = ir_gpio[i] - lane * 8;
+                if (bit >= 0 && bit < 8 && (b & (1 << bit))) {
+                    t[b] |= 1u << i;
+                }
+            }
+        }
+        s_gather_shift[s_gather_lanes++] = lane * 8;
+    }
+    return ESP_OK;
+}// eo _build_ir_gather::
+
+/*>>> _read_ir_mask: ==========================================================
+Author:		Vraj Patel, Samip Patel, Mihir Jariwala, Vamseedhar Reddy
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will sample the whole IR bank with one read of the GPIO input
+			register(s) and gather the IR bits into a slot bitmask. Cheap enough for the ISR
+			and for oversampling.
+Input: 		None
+Returns:	Bit i set if slot i is occupied (HIGH).
+ ============================================================================*/
+static inline uint16_t IRAM_ATTR _read_ir_mask(void)
+{
+    uint64_t in = REG_READ(GPIO_IN_REG);
+    if (s_ir_pins >> 32) {
+        in |= (uint64_t)REG_READ(GPIO_IN1_REG) << 32; // GPIO32..39
+    }
+    uint16_t mask = 0;
+    for (int l = 0; l < s_gather_lanes; l++) {
+        mask |= s_gather[l][(in >> s_gather_shift[l]) & 0xFF];
+    }
+    return mask;
+}// eo _read_ir_mask::
 
 /*>>> sensors_init: ==========================================================
 Author:		Vraj Patel, Samip Patel, Mihir Jariwala, Vamseedhar Reddy
 Date:		10/07/2025
-Modified:	02/08/2025
+Modified:	17/10/2026
 Desc:		This function will initialize the sensor management system,
 			configuring all necessary GPIOs and initializing the Proximity sensor, Spill sensor, and BMX-20 sensor.
 Input: 		None
@@ -38,44 +151,71 @@ Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
 esp_err_t sensors_init(void)
 {
-    // 1) Configure IR inputs (active‑high with pull‑up)
+    // 1) Configure IR inputs (active‑high with pull‑up), the whole bank in one call
+    esp_err_t err = _build_ir_gather();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "IR pins span too many GPIO bytes");
+        return err;
+    }
     gpio_config_t io_conf = {
+        .pin_bit_mask   = s_ir_pins,
         .mode           = GPIO_MODE_INPUT,
         .pull_up_en     = GPIO_PULLUP_ENABLE,
         .pull_down_en   = GPIO_PULLDOWN_DISABLE,
-        .intr_type      = GPIO_INTR_DISABLE,
+        .intr_type      = GPIO_INTR_ANYEDGE,
     };
-    for (int i = 0; i < SHELF_SLOTS; i++) {
-        io_conf.pin_bit_mask = 1ULL << ir_gpio[i];
-        gpio_config(&io_conf);
-    }
+    gpio_config(&io_conf);
 
     // 2) Spill detector (also active‑high)
     io_conf.pin_bit_mask = 1ULL << SPILL_GPIO;
+    io_conf.intr_type    = GPIO_INTR_DISABLE;
     gpio_config(&io_conf);
 
-    // 3) Initialize BMX20 (assumes I²C already set up in main)
-    esp_err_t err = bmx20_init(&s_bmx20_dev, I2C_NUM_0,
-                               GPIO_NUM_21, GPIO_NUM_22, 100000);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "BMX20 init failed: %s", esp_err_to_name(err));
+    // Start edge capture from the current state
+    s_occ_stable = s_pend_level = _read_ir_mask();
+    err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "GPIO ISR service failed: %s", esp_err_to_name(err));
+        return err;
     }
-    return err;
+    for (int i = 0; i < SHELF_SLOTS; i++) {
+        gpio_isr_handler_add(ir_gpio[i], _ir_isr, (void *)(intptr_t)i);
+    }
+
+    // 3) Initialize the BMX20 pairs (assumes I²C already set up in main)
+    bmx20_i2c_open(&s_i2c, I2C_NUM_0);
+    bmx20_mux_init(&s_env_mux, &s_i2c.base, ENV_MUX_ADDR);
+    int ok = 0;
+    for (size_t i = 0; i < ENV_POINTS; i++) {
+        bmx20_bus_t *bus = &s_i2c.base;
+        if (s_env_channel[i] != ENV_NO_MUX) {
+            bmx20_mux_channel_init(&s_env_bus[i], &s_env_mux, s_env_channel[i]);
+            bus = &s_env_bus[i].base;
+        }
+        s_env_devp[i] = &s_env_dev[i];
+        err = bmx20_init_bus(&s_env_dev[i], bus);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "BMX20 #%u init failed: %s", (unsigned)i, esp_err_to_name(err));
+        } else {
+            ok++;
+        }
+    }
+    return ok ? ESP_OK : err;
 }
 
 /*>>> _read_all_ir: ==========================================================
 Author:		Vraj Patel, Samip Patel, Mihir Jariwala, Vamseedhar Reddy
 Date:		10/07/2025
-Modified:	02/08/2025
+Modified:	17/10/2026
 Desc:		This function will read all IR sensor values and store them in the provided array.
 Input: 		- out_ir: Array to store the read IR sensor values
 Returns:	None
  ============================================================================*/
 static void _read_all_ir(bool out_ir[SHELF_SLOTS])
 {
+    uint16_t mask = _read_ir_mask(); // HIGH = occupied
     for (int i = 0; i < SHELF_SLOTS; i++) {
-        // HIGH = occupied
-        out_ir[i] = (gpio_get_level(ir_gpio[i]) == 1);
+        out_ir[i] = (mask >> i) & 1;
     }
 }// eo _read_all_ir::
 
@@ -92,31 +232,219 @@ static bool _read_spill(void)
     return (gpio_get_level(SPILL_GPIO) == 1);
 }// eo _read_spill::
 
+/*>>> sensors_env_trigger: ==========================================================
+Author:		Vraj Patel, Samip Patel, Mihir Jariwala, Vamseedhar Reddy
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will start the temperature/humidity conversion of every climate
+			point so that a later sensors_read() collects them instead of waiting.
+			Even if no conversion started, the next sensors_read() only collects
+			(and reports the trigger errors) rather than retrying with a blocking read.
+Input: 		None
+Returns:	ESP_OK if at least one conversion started, or the trigger error.
+ ============================================================================*/
+esp_err_t sensors_env_trigger(void)
+{
+    esp_err_t first = ESP_OK;
+    int started = 0;
+    for (size_t i = 0; i < ENV_POINTS; i++) {
+        esp_err_t err = bmx20_humidity_trigger(&s_env_dev[i]);
+        s_env_last[i].err = err;
+        if (err == ESP_OK) {
+            started++;
+        } else {
+            ESP_LOGW(TAG, "Humidity trigger #%u failed: %s", (unsigned)i, esp_err_to_name(err));
+            first = first ? first : err;
+        }
+    }
+    s_env_triggered = true;
+    return started ? ESP_OK : first;
+}// eo sensors_env_trigger::
+
 /*>>> sensors_read: ==========================================================
 Author:		Vraj Patel, Samip Patel, Mihir Jariwala, Vamseedhar Reddy
 Date:		10/07/2025
-Modified:	02/08/2025
+Modified:	17/10/2026
 Desc:		This function will read all sensor values (IR, spill, temperature, humidity)
-			and store them in the provided sensor_data_t structure.
+			and store them in the provided sensor_data_t structure. After
+			sensors_env_trigger() it only collects the conversion and returns
+			ESP_ERR_NOT_FINISHED until every point is ready; otherwise it reads all
+			points as one pipeline (trigger all, one wait, collect all).
+			Temperature and humidity come from the same AHT20 frame, so a sample is
+			one I2C read per point; the BMP280 is not touched.
+			The IR and spill inputs are read even if no climate point was; the
+			primary temperature/humidity then repeat the last good reading.
 Input: 		- out: Pointer to the sensor_data_t structure to fill
-Returns:	ESP_OK on success, or an error code on failure.
+Returns:	ESP_OK on success, ESP_ERR_NOT_FINISHED, or an error code on failure.
  ============================================================================*/
 esp_err_t sensors_read(sensor_data_t *out)
 {
     if (!out) {
         return ESP_ERR_INVALID_ARG;
     }
-    _read_all_ir(out->prox);
-    out->spill = _read_spill();
+    if (s_env_triggered) {
+        bool busy = false;
+        for (size_t i = 0; i < ENV_POINTS; i++) {
+            if (!s_env_dev[i].aht_pending) continue;
+            env_reading_t *r = &s_env_last[i];
+            esp_err_t err = bmx20_env_collect(&s_env_dev[i], &r->temperature, &r->humidity);
+            if (err == ESP_ERR_NOT_FINISHED) {
+                busy = true;
+            } else {
+                r->err = err;
+            }
+        }
+        if (busy) {
+            return ESP_ERR_NOT_FINISHED;
+        }
+        s_env_triggered = false;
+    } else {
+        float t[ENV_POINTS], h[ENV_POINTS];
+        esp_err_t e[ENV_POINTS];
+        bmx20_read_env_many(s_env_devp, ENV_POINTS, t, h, e);
+        for (size_t i = 0; i < ENV_POINTS; i++) {
+            s_env_last[i] = (env_reading_t){ .temperature = t[i], .humidity = h[i], .err = e[i] };
+        }
+    }
 
-    esp_err_t err = bmx20_read_temperature(&s_bmx20_dev, &out->temperature);
-    if (err != ESP_OK) {
-        ESP_LOGW(TAG, "Temp read failed: %s", esp_err_to_name(err));
-        return err;
+    esp_err_t err = ESP_FAIL;
+    out->env_count = ENV_POINTS;
+    for (size_t i = ENV_POINTS; i-- > 0; ) { // primary reading = first point that was read
+        out->env[i] = s_env_last[i];
+        if (s_env_last[i].err == ESP_OK) {
+            out->temperature = s_env_last[i].temperature;
+            out->humidity    = s_env_last[i].humidity;
+            err = ESP_OK;
+        } else {
+            ESP_LOGW(TAG, "Temp/humidity #%u read failed: %s", (unsigned)i,
+                     esp_err_to_name(s_env_last[i].err));
+            err = (err == ESP_OK) ? ESP_OK : s_env_last[i].err;
+        }
     }
-    err = bmx20_read_humidity(&s_bmx20_dev, &out->humidity);
-    if (err != ESP_OK) {
-        ESP_LOGW(TAG, "Humidity read failed: %s", esp_err_to_name(err));
+    if (err == ESP_OK) {
+        s_env_good_t = out->temperature;
+        s_env_good_h = out->humidity;
+    } else {
+        out->temperature = s_env_good_t;
+        out->humidity    = s_env_good_h;
     }
+
+    _read_all_ir(out->prox);
+    out->spill = _read_spill();
     return err;
 }// eo sensors_read::
+
+/*>>> _ir_isr: ==========================================================
+Author:		Vraj Patel, Samip Patel, Mihir Jariwala, Vamseedhar Reddy
+Date:		17/10/2026
+Modified:	None
+Desc:		Any-edge interrupt of one IR input: timestamp the edge and push it into the ring.
+			If the ring is full the edge is dropped and the overrun flag tells the task to
+			re-read the pins.
+Input: 		- arg: Slot index
+Returns:	None
+ ============================================================================*/
+static void IRAM_ATTR _ir_isr(void *arg)
+{
+    int      slot = (int)(intptr_t)arg;
+    uint32_t head = s_ring_head;
+    if (head - __atomic_load_n(&s_ring_tail, __ATOMIC_ACQUIRE) >= IR_EDGE_RING_LEN) {
+        s_ring_overrun = true;
+        return;
+    }
+    ir_edge_t *e = &s_ring[head & (IR_EDGE_RING_LEN - 1)];
+    e->time_us = esp_timer_get_time();
+    e->slot    = slot;
+    e->level   = (_read_ir_mask() >> slot) & 1;
+    __atomic_store_n(&s_ring_head, head + 1, __ATOMIC_RELEASE); // publish after the entry is written
+}// eo _ir_isr::
+
+/*>>> _settle: ==========================================================
+Author:		Vraj Patel, Samip Patel, Mihir Jariwala, Vamseedhar Reddy
+Date:		17/10/2026
+Modified:	None
+Desc:		Report the pending level of a slot if it held for IR_SETTLE_US before `until`
+			and differs from the reported state.
+Input: 		- slot: IR slot
+			- until: Time of the next edge on the slot, or now
+			- cb, ctx: Change callback
+Returns:	1 if a change was reported, else 0.
+ ============================================================================*/
+static int _settle(int slot, int64_t until, occ_change_cb_t cb, void *ctx)
+{
+    uint16_t bit = 1u << slot;
+    if (!(s_pend_valid & bit) || until - s_pend_time[slot] < IR_SETTLE_US) {
+        return 0;
+    }
+    s_pend_valid &= ~bit;
+    if ((s_pend_level ^ s_occ_stable) & bit) {
+        s_occ_stable ^= bit;
+        if (cb) {
+            occ_change_t c = { .slot = slot, .occupied = (s_occ_stable & bit) != 0, .time_us = s_pend_time[slot] };
+            cb(&c, ctx);
+        }
+        return 1;
+    }
+    return 0;
+}// eo _settle::
+
+/*>>> sensors_poll_occupancy: ==========================================================
+Author:		Vraj Patel, Samip Patel, Mihir Jariwala, Vamseedhar Reddy
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will drain the IR edge ring in time order. Each edge ends the
+			previous level of its slot, which is reported if it held for IR_SETTLE_US (so
+			contact bounce is ignored but a short real pulse is not); the latest level of
+			each slot is reported once it has held that long up to now.
+Input: 		- cb, ctx: Change callback
+			- occ: Receives the debounced occupancy bitmask
+Returns:	Number of changes reported.
+ ============================================================================*/
+int sensors_poll_occupancy(occ_change_cb_t cb, void *ctx, uint16_t *occ)
+{
+    int      n    = 0;
+    uint32_t tail = s_ring_tail;
+    uint32_t head = __atomic_load_n(&s_ring_head, __ATOMIC_ACQUIRE);
+
+    for (; tail != head; tail++) {
+        const ir_edge_t *e = &s_ring[tail & (IR_EDGE_RING_LEN - 1)];
+        uint16_t bit = 1u << e->slot;
+        n += _settle(e->slot, e->time_us, cb, ctx);
+        s_pend_level = e->level ? (s_pend_level | bit) : (s_pend_level & ~bit);
+        s_pend_time[e->slot] = e->time_us;
+        s_pend_valid |= bit;
+    }
+    __atomic_store_n(&s_ring_tail, tail, __ATOMIC_RELEASE); // free the slots for the ISR
+
+    int64_t now = esp_timer_get_time();
+    if (s_ring_overrun) {
+        // edges were lost: take the pins as they are now as a fresh edge on every slot
+        s_ring_overrun = false;
+        s_overruns++;
+        s_pend_level = _read_ir_mask();
+        for (int i = 0; i < SHELF_SLOTS; i++) {
+            s_pend_time[i] = now - IR_SETTLE_US;
+        }
+        s_pend_valid = OCC_ALL;
+    }
+    for (int i = 0; i < SHELF_SLOTS; i++) {
+        n += _settle(i, now, cb, ctx);
+    }
+    if (occ) {
+        *occ = s_occ_stable;
+    }
+    return n;
+}// eo sensors_poll_occupancy::
+
+/*>>> sensors_ir_overruns: ==========================================================
+Author:		Vraj Patel, Samip Patel, Mihir Jariwala, Vamseedhar Reddy
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will return how often the IR edge ring overflowed.
+Input: 		None
+Returns:	Overrun count.
+ ============================================================================*/
+uint32_t sensors_ir_overruns(void)
+{
+    return s_overruns;
+}// eo sensors_ir_overruns::
@@ -2,7 +2,7 @@
 File Name:	sensors.h
 Author:		Vraj Patel, Samip Patel, Mihir Jariwala, Vamseedhar Reddy
 Date:		10/07/2025
-Modified:	None
+Modified:	17/10/2026
 © Fanshawe College, 2025
 
 Description: This file contains the definitions and function prototypes for the sensor management
@@ -13,18 +13,42 @@ system (IR, spill), including the BMX-20 sensor.
 #define SENSORS_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "esp_err.h"
 #include "driver/gpio.h"
 
 #define SHELF_SLOTS   10
 #define PROX_COUNT    SHELF_SLOTS
 #define SPILL_GPIO    GPIO_NUM_32
+#define OCC_POLL_MS   10    // How often the acquisition task drains the IR edge ring
+#define IR_EDGE_RING_LEN  64    // Captured IR edges awaiting the task (power of two)
+#define IR_SETTLE_US      2000  // A level must hold this long to count as a state change
+#define ENV_MUX_ADDR      0x70  // TCA9548A in front of the climate sensor pairs
+#define ENV_NO_MUX        -1    // Channel value for a pair wired straight to the bus
+#define ENV_POINTS_MAX    8     // Climate points one transmitter can watch
+
+typedef struct {
+    uint8_t  slot;      // IR slot that changed
+    bool     occupied;  // its new state
+    int64_t  time_us;   // esp_timer time of the edge after which the level held
+} occ_change_t; // One debounced occupancy change
+
+/// Called by sensors_poll_occupancy() for each change, oldest first.
+typedef void (*occ_change_cb_t)(const occ_change_t *change, void *ctx);
+
+typedef struct {
+    float     temperature;
+    float     humidity;
+    esp_err_t err;       // ESP_OK if the values are from this sample
+} env_reading_t; // One climate point
 
 typedef struct {
     bool     prox[PROX_COUNT];
     bool     spill;
-    float    temperature;
+    float    temperature;   // first climate point that was read (else the last good one)
     float    humidity;
+    uint8_t  env_count;     // climate points fitted
+    env_reading_t env[ENV_POINTS_MAX];
 } sensor_data_t;
 
 /**
@@ -34,8 +58,35 @@ typedef struct {
 esp_err_t sensors_init(void);
 
 /**
- * @brief   Read all 10 IR bits, the spill bit, and temp/humidity.
+ * @brief   Start the temperature/humidity conversion of every climate point
+ *          without waiting for it (~80 ms; the points convert in parallel).
+ */
+esp_err_t sensors_env_trigger(void);
+
+/**
+ * @brief   Read all 10 IR bits, the spill bit, and temp/humidity of every
+ *          climate point.
+ * @return  After sensors_env_trigger(): ESP_ERR_NOT_FINISHED until every
+ *          conversion is ready (nothing written). Without a trigger it
+ *          blocks the task for one shared conversion time. Fails only if no
+ *          climate point could be read; IR and spill are still filled in and
+ *          temperature/humidity repeat the last good reading.
  */
 esp_err_t sensors_read(sensor_data_t *out);
 
+/**
+ * @brief   Drain the IR edges captured by the GPIO interrupt and report every
+ *          level that held for at least IR_SETTLE_US as a change, with the
+ *          timestamp of its edge. Pulses shorter than a poll period are not
+ *          lost. Call every OCC_POLL_MS from one task.
+ * @param   cb   Called per change (may be NULL)
+ * @param   ctx  Passed to cb
+ * @param   occ  Receives the debounced occupancy, bit i = slot i
+ * @return  Number of changes reported
+ */
+int sensors_poll_occupancy(occ_change_cb_t cb, void *ctx, uint16_t *occ);
+
+/// Edges lost because the ring was full (the state is then re-read from the pins).
+uint32_t sensors_ir_overruns(void);
+
 #endif // SENSORS_H
@@ -0,0 +1,22 @@
+/*======================================================================================================
+File Name:	host_tests.h
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file lists the groups of host tests run by test_main.c. Each group lives in its
+own test_*.c file and runs its tests with RUN_TEST().
+====================================================================================================*/
+
+#ifndef HOST_TESTS_H
+#define HOST_TESTS_H
+
+void run_lcd_emu_tests(void);
+void run_lcd_render_tests(void);
+void run_lcd_printf_tests(void);
+void run_sensor_frame_tests(void);
+void run_scan_pipeline_tests(void);
+void run_net_reactor_tests(void);
+
+#endif // HOST_TESTS_H
@@ -0,0 +1,211 @@
+/*======================================================================================================
+File Name:	test_lcd_emu.c
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the host tests of the LCD driver's framebuffer commit, run through
+the PCF8574 + HD44780 emulator: what the panel shows afterwards and how many expander bytes it
+cost. A commit sends one DDRAM address plus the changed cells of each run, LCD_BYTES_PER_CHAR
+expander bytes per LCD byte. A glyph miss must not evict a glyph the same frame still shows.
+====================================================================================================*/
+
+#include <string.h>
+#include "unity.h"
+#include "host_tests.h"
+#include "lcd_20x4_driver.h"
+#include "lcd_20x4_emu.h"
+
+#define EMU_CLK_HZ  100000
+
+static lcd_20x4_driver_t s_lcd;   // large (burst buffer), so not on the stack
+static lcd20x4_emu_t     s_emu;
+
+static const char *const s_text[LCD_ROWS_MAX] = {
+    "ABCDEFGHIJKLMNOPQRST",
+    "abcdefghijklmnopqrst",
+    "0123456789!#$&()*+,/",
+    "<=>?@[]^_{|}~;:.'`\"-",
+};
+
+/*>>> open_panel: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will initialise the driver over a fresh emulator and
+			zero both traffic counters.
+Input: 		- cols: Panel width
+Returns:	None
+ ============================================================================*/
+static void open_panel(uint8_t cols)
+{
+    lcd20x4_emu_init(&s_emu, EMU_CLK_HZ);
+    TEST_ASSERT_EQUAL(ESP_OK, lcd20x4_init_io(&s_lcd, &s_emu.base, true, LCD_ROWS_MAX, cols));
+    lcd20x4_emu_reset_counters(&s_emu);
+    lcd20x4_reset_stats(&s_lcd);
+}// eo open_panel::
+
+/*>>> check_rows: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will compare every row the emulated panel shows with
+			the first `cols` characters of s_text.
+Input: 		- cols: Panel width
+Returns:	None
+ ============================================================================*/
+static void check_rows(uint8_t cols)
+{
+    char want[LCD_COLS_MAX + 1];
+    char got[LCD_COLS_MAX + 1];
+    for (uint8_t row = 0; row < LCD_ROWS_MAX; row++) {
+        memcpy(want, s_text[row], cols);
+        want[cols] = '\0';
+        lcd20x4_emu_row(&s_emu, row, cols, got);
+        TEST_ASSERT_EQUAL_STRING(want, got);
+    }
+}// eo check_rows::
+
+/*>>> commit_full_screen: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will write every cell of the panel and commit it.
+Input: 		- cols: Panel width
+Returns:	None
+ ============================================================================*/
+static void commit_full_screen(uint8_t cols)
+{
+    char line[LCD_COLS_MAX + 1];
+    for (uint8_t row = 0; row < LCD_ROWS_MAX; row++) {
+        memcpy(line, s_text[row], cols);
+        line[cols] = '\0';
+        lcd20x4_fb_write(&s_lcd, 0, row, line);
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, lcd20x4_commit(&s_lcd));
+}// eo commit_full_screen::
+
+static void test_init_configures_controller(void)
+{
+    open_panel(LCD_COLS_MAX);
+    TEST_ASSERT_FALSE(s_emu.eight_bit);
+    TEST_ASSERT_TRUE(s_emu.two_line);
+    TEST_ASSERT_TRUE(s_emu.display_on);
+    TEST_ASSERT_TRUE(s_emu.inc);
+    TEST_ASSERT_EQUAL_UINT32(0, s_emu.busy_violations);
+}
+
+static void test_init_reports_absent_panel(void)
+{
+    lcd20x4_emu_init(&s_emu, EMU_CLK_HZ);
+    s_emu.absent = true;
+    TEST_ASSERT_EQUAL(ESP_FAIL, lcd20x4_init_io(&s_lcd, &s_emu.base, true, LCD_ROWS_MAX, LCD_COLS_MAX));
+    TEST_ASSERT_EQUAL_UINT32(1, s_emu.transactions); // gave up at the first nibble
+}
+
+static void test_full_screen_20x4(void)
+{
+    open_panel(20);
+    commit_full_screen(20);
+    check_rows(20);
+    TEST_ASSERT_EQUAL_UINT32(504, s_emu.bytes); // 4 x (address + 20 cells) x 6
+    TEST_ASSERT_EQUAL_UINT32(1, s_emu.transactions);
+    TEST_ASSERT_EQUAL_UINT32(0, s_emu.busy_violations);
+
+    lcd20x4_stats_t st;
+    lcd20x4_get_stats(&s_lcd, &st);
+    TEST_ASSERT_EQUAL_UINT32(s_emu.bytes, st.bytes);
+}
+
+static void test_full_screen_16x4(void)
+{
+    open_panel(16);
+    commit_full_screen(16);
+    check_rows(16);
+    TEST_ASSERT_EQUAL_UINT32(408, s_emu.bytes); // 4 x (address + 16 cells) x 6
+    TEST_ASSERT_EQUAL_UINT32(0, s_emu.busy_violations);
+}
+
+static void test_unchanged_commit_sends_nothing(void)
+{
+    open_panel(20);
+    commit_full_screen(20);
+    lcd20x4_emu_reset_counters(&s_emu);
+
+    commit_full_screen(20);
+    TEST_ASSERT_EQUAL_UINT32(0, s_emu.bytes);
+    TEST_ASSERT_EQUAL_UINT32(0, s_emu.transactions);
+    check_rows(20);
+}
+
+static void test_one_cell_change(void)
+{
+    open_panel(20);
+    commit_full_screen(20);
+    lcd20x4_emu_reset_counters(&s_emu);
+
+    lcd20x4_fb_write(&s_lcd, 7, 2, "X");
+    TEST_ASSERT_EQUAL(ESP_OK, lcd20x4_commit(&s_lcd));
+    TEST_ASSERT_EQUAL_UINT32(2 * LCD_BYTES_PER_CHAR, s_emu.bytes); // address + cell
+
+    char got[LCD_COLS_MAX + 1];
+    lcd20x4_emu_row(&s_emu, 2, 20, got);
+    TEST_ASSERT_EQUAL_STRING("0123456X89!#$&()*+,/", got);
+}
+
+static void test_glyph_miss_keeps_frame_glyphs(void)
+{
+    static lcd20x4_glyph_t glyphs[LCD_CGRAM_SLOTS + 1];
+    for (uint8_t id = 0; id <= LCD_CGRAM_SLOTS; id++) {
+        memset(glyphs[id].rows, id + 1, sizeof(glyphs[id].rows));
+    }
+    open_panel(20);
+    lcd20x4_set_glyph_table(&s_lcd, glyphs, LCD_CGRAM_SLOTS + 1);
+
+    // previous frame: glyphs 0..7 fill every slot
+    lcd20x4_fb_clear(&s_lcd);
+    for (uint8_t id = 0; id < LCD_CGRAM_SLOTS; id++) {
+        lcd20x4_frame_glyph(&s_lcd.fb, id, 0, id);
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, lcd20x4_commit(&s_lcd));
+    TEST_ASSERT_EQUAL_UINT32(LCD_CGRAM_SLOTS, s_emu.cgram_sets);
+    lcd20x4_emu_reset_counters(&s_emu);
+
+    // new frame: glyph 8 first, then 0..6; only glyph 7 may go
+    lcd20x4_fb_clear(&s_lcd);
+    lcd20x4_frame_glyph(&s_lcd.fb, 0, 0, LCD_CGRAM_SLOTS);
+    for (uint8_t id = 0; id < LCD_CGRAM_SLOTS - 1; id++) {
+        lcd20x4_frame_glyph(&s_lcd.fb, id + 1, 0, id);
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, lcd20x4_commit(&s_lcd));
+    TEST_ASSERT_EQUAL_UINT32(1, s_emu.cgram_sets);
+
+    // every cell shows the bitmap it asked for
+    char got[LCD_COLS_MAX + 1];
+    lcd20x4_emu_row(&s_emu, 0, 20, got);
+    for (uint8_t col = 0; col < LCD_CGRAM_SLOTS; col++) {
+        uint8_t id = col ? col - 1 : LCD_CGRAM_SLOTS;
+        uint8_t slot = ((uint8_t)got[col] - LCD_GLYPH_CODE_BASE) & (LCD_CGRAM_SLOTS - 1);
+        TEST_ASSERT_EQUAL_UINT8(id + 1, s_emu.cgram_data[slot * LCD_GLYPH_ROWS]);
+    }
+}
+
+/*>>> run_lcd_emu_tests: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will run the emulator tests.
+Input: 		None
+Returns:	None
+ ============================================================================*/
+void run_lcd_emu_tests(void)
+{
+    RUN_TEST(test_init_configures_controller);
+    RUN_TEST(test_init_reports_absent_panel);
+    RUN_TEST(test_full_screen_20x4);
+    RUN_TEST(test_full_screen_16x4);
+    RUN_TEST(test_unchanged_commit_sends_nothing);
+    RUN_TEST(test_one_cell_change);
+    RUN_TEST(test_glyph_miss_keeps_frame_glyphs);
+}// eo run_lcd_emu_tests::
@@ -0,0 +1,146 @@
+/*======================================================================================================
+File Name:	test_lcd_printf.c
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the host tests of lcd20x4_frame_printf: its output for the
+conversions it shares with snprintf must match snprintf cell for cell, and a microbenchmark of the
+two (format + place into a frame) prints the time per call. Timings are reported, not asserted.
+====================================================================================================*/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "unity.h"
+#include "host_tests.h"
+#include "lcd_20x4_driver.h"
+
+#define BENCH_CALLS  200000
+
+typedef struct {
+    const char *fmt;
+    double      f;
+    int         i;
+} fmt_case_t; // One format with its arguments (a double, then an int)
+
+// no exact binary ties (x.x5 stored exactly): those round away from zero here, to even in glibc
+static const fmt_case_t s_cases[] = {
+    { "Temp: %5.1f C",     21.54,   0 },
+    { "Hum: %.2f %%",      45.0,    0 },
+    { "T=%.1f n=%d",       -3.27,   -17 },
+    { "%08.3f|%-5d|",      12.3456, 42 },
+    { "%.0f  %4d",         99.6,    7 },
+    { "%-8.1f|%u",         0.04,    65535 },
+};
+
+/*>>> frame_row: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will copy row 0 of a frame as a NUL-terminated string
+			with trailing blanks removed.
+Input: 		- frame: Frame to read
+			- out: LCD_COLS_MAX + 1 bytes
+Returns:	None
+ ============================================================================*/
+static void frame_row(const lcd20x4_frame_t *frame, char *out)
+{
+    int n = LCD_COLS_MAX;
+    memcpy(out, frame->cells[0], n);
+    while (n > 0 && out[n - 1] == ' ') n--;
+    out[n] = '\0';
+}// eo frame_row::
+
+/*>>> elapsed_ns: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will return the time between two monotonic stamps.
+Input: 		- a / b: Start and end
+Returns:	Nanoseconds.
+ ============================================================================*/
+static double elapsed_ns(const struct timespec *a, const struct timespec *b)
+{
+    return (b->tv_sec - a->tv_sec) * 1e9 + (b->tv_nsec - a->tv_nsec);
+}// eo elapsed_ns::
+
+static void test_printf_matches_snprintf(void)
+{
+    lcd20x4_frame_t frame;
+    char want[64];
+    char got[LCD_COLS_MAX + 1];
+    for (size_t k = 0; k < sizeof(s_cases) / sizeof(s_cases[0]); k++) {
+        const fmt_case_t *c = &s_cases[k];
+        snprintf(want, sizeof(want), c->fmt, c->f, c->i);
+        want[LCD_COLS_MAX] = '\0'; // the frame clips at the end of the row
+
+        lcd20x4_frame_clear(&frame);
+        int n = lcd20x4_frame_printf(&frame, 0, 0, c->fmt, c->f, c->i);
+        frame_row(&frame, got);
+        TEST_ASSERT_EQUAL_STRING(want, got);
+        TEST_ASSERT_EQUAL_INT((int)strlen(want), n);
+    }
+}
+
+static void test_printf_special_values(void)
+{
+    lcd20x4_frame_t frame;
+    char got[LCD_COLS_MAX + 1];
+
+    lcd20x4_frame_clear(&frame);
+    lcd20x4_frame_printf(&frame, 0, 0, "[%5.1f][%f][%.1f]", (double)NAN, (double)INFINITY, -(double)INFINITY);
+    frame_row(&frame, got);
+    TEST_ASSERT_EQUAL_STRING("[  nan][inf][-inf]", got);
+
+    lcd20x4_frame_clear(&frame);
+    lcd20x4_frame_printf(&frame, 0, 0, "%.4f", 1e300); // clamped, not undefined
+    frame_row(&frame, got);
+    TEST_ASSERT_EQUAL_STRING("429496.7295", got);
+}
+
+static void test_printf_benchmark(void)
+{
+    static volatile double s_temp = 21.54; // defeat constant folding
+    lcd20x4_frame_t frame;
+    char line[32];
+    struct timespec t0, t1, t2;
+    unsigned sink = 0;
+    lcd20x4_frame_clear(&frame);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int k = 0; k < BENCH_CALLS; k++) {
+        snprintf(line, sizeof(line), "Temp: %5.1f C %d", s_temp, k & 0xFF);
+        lcd20x4_frame_write(&frame, 0, 2, line);
+        sink += (uint8_t)frame.cells[2][7];
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for (int k = 0; k < BENCH_CALLS; k++) {
+        lcd20x4_frame_printf(&frame, 0, 2, "Temp: %5.1f C %d", s_temp, k & 0xFF);
+        sink += (uint8_t)frame.cells[2][7];
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+
+    double ns_snprintf = elapsed_ns(&t0, &t1) / BENCH_CALLS;
+    double ns_lcd      = elapsed_ns(&t1, &t2) / BENCH_CALLS;
+    printf("printf bench: snprintf+write %.0f ns/call, lcd20x4_frame_printf %.0f ns/call (x%.1f)\n",
+           ns_snprintf, ns_lcd, ns_snprintf / ns_lcd);
+    TEST_ASSERT_GREATER_THAN(0, sink);
+}
+
+/*>>> run_lcd_printf_tests: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will run the formatter tests and the benchmark.
+Input: 		None
+Returns:	None
+ ============================================================================*/
+void run_lcd_printf_tests(void)
+{
+    RUN_TEST(test_printf_matches_snprintf);
+    RUN_TEST(test_printf_special_values);
+    RUN_TEST(test_printf_benchmark);
+}// eo run_lcd_printf_tests::
@@ -0,0 +1,271 @@
+/*======================================================================================================
+File Name:	test_lcd_render.c
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the host tests of the LCD render task driving several panels, each
+over its own emulator. A tap in front of every emulator logs each transaction with its panel and
+wire time, as if the panels shared one bus, so the tests can check how the bus is split between
+panels per round and how long a small update waits behind a full redraw of another panel.
+====================================================================================================*/
+
+#include <string.h>
+#include "unity.h"
+#include "host_tests.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "lcd_20x4_driver.h"
+#include "lcd_20x4_emu.h"
+#include "lcd_render.h"
+
+#define EMU_CLK_HZ       100000
+#define RENDER_PANELS    3
+#define RENDER_LOG_MAX   64
+#define RENDER_WAIT_MS   1000   // longest wait for the render task to go quiet
+#define FULL_REDRAW      (LCD_ROWS_MAX * LCD_RENDER_QUANTUM) // bytes of a 20x4 redraw
+
+typedef struct {
+    lcd20x4_transport_t base;   // first member: the driver sees a transport
+    lcd20x4_emu_t       emu;    // panel behind the tap
+    uint8_t             panel;
+} render_tap_t; // Logging transport in front of one emulated panel
+
+typedef struct {
+    uint8_t  panel;
+    uint16_t bytes;
+    uint32_t wire_us;
+} render_xfer_t; // One logged transaction
+
+static lcd_20x4_driver_t       s_lcd[RENDER_PANELS];  // large (burst buffer), so not on the stack
+static render_tap_t            s_tap[RENDER_PANELS];
+static render_xfer_t           s_log[RENDER_LOG_MAX];
+static volatile uint32_t       s_log_len;             // written by the render task only
+
+/*>>> _tap_transmit: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will log a transaction and pass it to the emulator.
+Input: 		- io: Pointer to the tap
+			- data: The bytes to write
+			- len: Number of bytes
+Returns:	The emulator's result.
+ ============================================================================*/
+static esp_err_t _tap_transmit(lcd20x4_transport_t *io, const uint8_t *data, size_t len) {
+    render_tap_t *tap = (render_tap_t *)io;
+    uint32_t before = tap->emu.base.bus_time_us;
+    esp_err_t err = tap->emu.base.transmit(&tap->emu.base, data, len);
+    uint32_t wire_us = tap->emu.base.bus_time_us - before;
+    tap->base.bus_time_us += wire_us;
+    if (s_log_len < RENDER_LOG_MAX) {
+        s_log[s_log_len] = (render_xfer_t){ .panel = tap->panel, .bytes = (uint16_t)len, .wire_us = wire_us };
+    }
+    s_log_len++;
+    return err;
+}// eo _tap_transmit::
+
+/*>>> _tap_wait: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will wait on the emulator.
+Input: 		- io: Pointer to the tap
+Returns:	The emulator's result.
+ ============================================================================*/
+static esp_err_t _tap_wait(lcd20x4_transport_t *io) {
+    render_tap_t *tap = (render_tap_t *)io;
+    return tap->emu.base.wait(&tap->emu.base);
+}// eo _tap_wait::
+
+/*>>> _tap_now_us: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will return the emulator's virtual clock.
+Input: 		- io: Pointer to the tap
+Returns:	Virtual time in µs.
+ ============================================================================*/
+static int64_t _tap_now_us(lcd20x4_transport_t *io) {
+    render_tap_t *tap = (render_tap_t *)io;
+    return tap->emu.base.now_us(&tap->emu.base);
+}// eo _tap_now_us::
+
+/*>>> _tap_sleep_until: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will advance the emulator's virtual clock.
+Input: 		- io: Pointer to the tap
+			- deadline_us: Virtual time to advance to
+Returns:	None
+ ============================================================================*/
+static void _tap_sleep_until(lcd20x4_transport_t *io, int64_t deadline_us) {
+    render_tap_t *tap = (render_tap_t *)io;
+    tap->emu.base.sleep_until(&tap->emu.base, deadline_us);
+}// eo _tap_sleep_until::
+
+/*>>> fill_frame: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will fill every cell of a frame with one character,
+			so a panel showing anything else needs a full redraw.
+Input: 		- frame: Frame to fill
+			- c: Character
+Returns:	None
+ ============================================================================*/
+static void fill_frame(lcd20x4_frame_t *frame, char c)
+{
+    memset(frame->cells, c, sizeof(frame->cells));
+}// eo fill_frame::
+
+/*>>> publish_all: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will publish one frame per panel while the render task
+			cannot run, so its first round already sees all of them, and clear
+			the transaction log.
+Input: 		- frames: One frame per panel, NULL to leave a panel alone
+Returns:	None
+ ============================================================================*/
+static void publish_all(const lcd20x4_frame_t *const frames[RENDER_PANELS])
+{
+    UBaseType_t prio = uxTaskPriorityGet(NULL);
+    vTaskPrioritySet(NULL, LCD_RENDER_PRIORITY + 1);
+    s_log_len = 0;
+    for (uint8_t i = 0; i < RENDER_PANELS; i++) {
+        if (frames[i]) TEST_ASSERT_EQUAL(ESP_OK, lcd_render_publish_to(i, frames[i]));
+    }
+    vTaskPrioritySet(NULL, prio);
+}// eo publish_all::
+
+/*>>> wait_quiet: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will wait until the render task has sent something,
+			then nothing more for a few ticks.
+Input: 		None
+Returns:	None
+ ============================================================================*/
+static void wait_quiet(void)
+{
+    uint32_t seen = UINT32_MAX;
+    for (int ms = 0; ms < RENDER_WAIT_MS && (seen != s_log_len || !s_log_len); ms += 30) {
+        seen = s_log_len;
+        vTaskDelay(pdMS_TO_TICKS(30));
+    }
+}// eo wait_quiet::
+
+/*>>> check_panel: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will check that a panel shows a frame.
+Input: 		- panel: Panel index
+			- frame: Expected frame
+Returns:	None
+ ============================================================================*/
+static void check_panel(uint8_t panel, const lcd20x4_frame_t *frame)
+{
+    char want[LCD_COLS_MAX + 1];
+    char got[LCD_COLS_MAX + 1];
+    for (uint8_t row = 0; row < LCD_ROWS_MAX; row++) {
+        memcpy(want, frame->cells[row], LCD_COLS_MAX);
+        want[LCD_COLS_MAX] = '\0';
+        lcd20x4_emu_row(&s_tap[panel].emu, row, LCD_COLS_MAX, got);
+        TEST_ASSERT_EQUAL_STRING(want, got);
+    }
+}// eo check_panel::
+
+static void test_full_redraws_share_the_bus(void)
+{
+    static lcd20x4_frame_t frames[RENDER_PANELS];
+    const lcd20x4_frame_t *pub[RENDER_PANELS];
+    for (uint8_t i = 0; i < RENDER_PANELS; i++) {
+        fill_frame(&frames[i], (char)('A' + i));
+        pub[i] = &frames[i];
+    }
+    publish_all(pub);
+    wait_quiet();
+
+    // one quantum per panel per round, panels in turn
+    uint32_t rounds = FULL_REDRAW / LCD_RENDER_QUANTUM;
+    TEST_ASSERT_EQUAL_UINT32(RENDER_PANELS * rounds, s_log_len);
+    for (uint32_t i = 0; i < s_log_len; i++) {
+        TEST_ASSERT_EQUAL_UINT8(i % RENDER_PANELS, s_log[i].panel);
+        TEST_ASSERT_EQUAL_UINT32(LCD_RENDER_QUANTUM, s_log[i].bytes);
+    }
+    for (uint8_t i = 0; i < RENDER_PANELS; i++) {
+        check_panel(i, &frames[i]);
+    }
+}
+
+static void test_small_update_latency(void)
+{
+    static lcd20x4_frame_t big, small;
+    fill_frame(&big, 'x');
+    fill_frame(&small, 'B'); // what panel 1 shows since the previous test
+    small.cells[2][7] = '*';
+    const lcd20x4_frame_t *pub[RENDER_PANELS] = { &big, &small, NULL };
+    publish_all(pub);
+    wait_quiet();
+
+    // panel 1 is done after its first turn; add up the bus traffic until then
+    uint32_t other_bytes = 0, latency_us = 0, redraw_us = 0;
+    int32_t  done = -1;
+    for (uint32_t i = 0; i < s_log_len && i < RENDER_LOG_MAX; i++) {
+        if (s_log[i].panel == 0) redraw_us += s_log[i].wire_us;
+        if (done >= 0) continue;
+        latency_us += s_log[i].wire_us;
+        if (s_log[i].panel == 1) {
+            TEST_ASSERT_EQUAL_UINT32(2 * LCD_BYTES_PER_CHAR, s_log[i].bytes); // address + cell
+            done = (int32_t)i;
+        } else {
+            other_bytes += s_log[i].bytes;
+        }
+    }
+    TEST_ASSERT_TRUE(done >= 0);
+    TEST_ASSERT_TRUE(other_bytes <= (RENDER_PANELS - 1) * LCD_RENDER_QUANTUM);
+    TEST_ASSERT_TRUE(latency_us < redraw_us / 2); // not behind the whole redraw
+    check_panel(0, &big);
+    check_panel(1, &small);
+}
+
+/*>>> run_lcd_render_tests: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will set up RENDER_PANELS tapped panels, start the render
+			task with them and run the render tests.
+Input: 		None
+Returns:	None
+ ============================================================================*/
+void run_lcd_render_tests(void)
+{
+    for (uint8_t i = 0; i < RENDER_PANELS; i++) {
+        render_tap_t *tap = &s_tap[i];
+        lcd20x4_emu_init(&tap->emu, EMU_CLK_HZ);
+        tap->base.transmit    = _tap_transmit;
+        tap->base.wait        = _tap_wait;
+        tap->base.now_us      = _tap_now_us;
+        tap->base.sleep_until = _tap_sleep_until;
+        tap->panel            = i;
+        if (lcd20x4_init_io(&s_lcd[i], &tap->base, true, LCD_ROWS_MAX, LCD_COLS_MAX) != ESP_OK) {
+            TEST_MESSAGE("panel init failed, skipping the render tests");
+            return;
+        }
+    }
+    uint8_t panel;
+    if (lcd_render_start(&s_lcd[0]) != ESP_OK ||
+        lcd_render_add_panel(&s_lcd[1], &panel) != ESP_OK ||
+        lcd_render_add_panel(&s_lcd[2], &panel) != ESP_OK) {
+        TEST_MESSAGE("render task setup failed, skipping the render tests");
+        return;
+    }
+    RUN_TEST(test_full_redraws_share_the_bus);
+    RUN_TEST(test_small_update_latency);
+}// eo run_lcd_render_tests::
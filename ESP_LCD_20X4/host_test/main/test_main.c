@@ -0,0 +1,37 @@
+/*======================================================================================================
+File Name:	test_main.c
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the entry point of the host tests. It runs every test group and
+exits with the number of failures, so the build can be used as a pass/fail gate.
+====================================================================================================*/
+
+#include <stdlib.h>
+#include "unity.h"
+#include "host_tests.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+/*>>> app_main: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will run all test groups and exit with the failure count.
+Input: 		None
+Returns:	None
+ ============================================================================*/
+void app_main(void)
+{
+    UNITY_BEGIN();
+    run_lcd_emu_tests();
+    run_lcd_render_tests();
+    run_lcd_printf_tests();
+    run_sensor_frame_tests();
+    run_scan_pipeline_tests();
+    run_net_reactor_tests();
+    exit(UNITY_END());
+}// eo app_main::
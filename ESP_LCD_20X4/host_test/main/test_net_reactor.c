@@ -0,0 +1,325 @@
+/*======================================================================================================
+File Name:	test_net_reactor.c
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the host tests of the network reactor and its line framers, run
+over loopback TCP: records split across segments or merged into one, an over-long record dropped
+whole, an idle client closed, and the connection pool turning away client NET_MAX_CONNS + 1.
+====================================================================================================*/
+
+#include <string.h>
+#include <unistd.h>
+#include "unity.h"
+#include "host_tests.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "lwip/sockets.h"
+#include "net_reactor.h"
+
+#define NET_TEST_PORT     47012
+#define NET_TEST_IDLE_MS  300   // idle timeout of the test port
+#define NET_TEST_TICK_MS  10    // reactor tick
+#define NET_TEST_WAIT_MS  1000  // longest wait for the reactor to catch up
+#define NET_TEST_LINES    8     // records kept by the handler
+
+static SemaphoreHandle_t s_lock;  // guards the records below (reactor task vs test)
+static char              s_lines[NET_TEST_LINES][LINE_FRAMER_MAX + 1];
+static int               s_line_count;
+
+/*>>> on_line: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Record handler of the test port: keep the first NET_TEST_LINES records.
+Input: net_conn_t *conn - Client.
+       const char *line - Record.
+       size_t len - Length of line.
+       void *ctx - Unused.
+Return: None
+=========================================================================================================*/
+static void on_line(net_conn_t *conn, const char *line, size_t len, void *ctx)
+{
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (s_line_count < NET_TEST_LINES)
+    {
+        memcpy(s_lines[s_line_count], line, len + 1);
+    }
+    s_line_count++;
+    xSemaphoreGive(s_lock);
+}// eo on_line::
+
+/*>>> reactor_task: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Run the reactor under test.
+Input: void *arg - Unused.
+Return: None
+=========================================================================================================*/
+static void reactor_task(void *arg)
+{
+    net_reactor_run(NET_TEST_TICK_MS, NULL, NULL);
+}// eo reactor_task::
+
+/*>>> line_count: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Read the number of records delivered so far.
+Input: None
+Return: int - Records delivered since the last reset_lines().
+=========================================================================================================*/
+static int line_count(void)
+{
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    int n = s_line_count;
+    xSemaphoreGive(s_lock);
+    return n;
+}// eo line_count::
+
+/*>>> reset_lines: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Forget the records delivered so far.
+Input: None
+Return: None
+=========================================================================================================*/
+static void reset_lines(void)
+{
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    s_line_count = 0;
+    xSemaphoreGive(s_lock);
+}// eo reset_lines::
+
+/*>>> wait_lines: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Wait until the handler has seen `n` records, then one tick more so that extra ones show.
+Input: int n - Records expected.
+Return: None
+=========================================================================================================*/
+static void wait_lines(int n)
+{
+    for (int ms = 0; ms < NET_TEST_WAIT_MS && line_count() < n; ms += NET_TEST_TICK_MS)
+    {
+        vTaskDelay(pdMS_TO_TICKS(NET_TEST_TICK_MS));
+    }
+    vTaskDelay(pdMS_TO_TICKS(2 * NET_TEST_TICK_MS));
+}// eo wait_lines::
+
+/*>>> wait_stat: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Wait until one reactor counter reaches a value.
+Input: size_t offset - offsetof() the counter in net_reactor_stats_t.
+       uint32_t want - Value to wait for.
+       uint32_t wait_ms - Longest wait.
+Return: uint32_t - The counter when the wait ended.
+=========================================================================================================*/
+static uint32_t wait_stat(size_t offset, uint32_t want, uint32_t wait_ms)
+{
+    net_reactor_stats_t st;
+    uint32_t v = 0;
+    for (uint32_t ms = 0; ; ms += NET_TEST_TICK_MS)
+    {
+        net_reactor_get_stats(&st);
+        memcpy(&v, (const uint8_t *)&st + offset, sizeof(v));
+        if (v >= want || ms >= wait_ms) return v;
+        vTaskDelay(pdMS_TO_TICKS(NET_TEST_TICK_MS));
+    }
+}// eo wait_stat::
+
+/*>>> client_open: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Connect a client to the test port over loopback. Reads time out instead of blocking for good.
+Input: None
+Return: int - Socket, or -1.
+=========================================================================================================*/
+static int client_open(void)
+{
+    struct sockaddr_in addr = {
+        .sin_family      = AF_INET,
+        .sin_port        = htons(NET_TEST_PORT),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    int fd = socket(AF_INET, SOCK_STREAM, IPPROTO_IP);
+    if (fd < 0) return -1;
+    struct timeval tv = { .tv_sec = NET_TEST_WAIT_MS / 1000, .tv_usec = (NET_TEST_WAIT_MS % 1000) * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}// eo client_open::
+
+/*>>> client_close: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Close a client and give the reactor time to free its slot.
+Input: int fd - Socket.
+Return: None
+=========================================================================================================*/
+static void client_close(int fd)
+{
+    close(fd);
+    vTaskDelay(pdMS_TO_TICKS(5 * NET_TEST_TICK_MS));
+}// eo client_close::
+
+static void test_split_record(void)
+{
+    reset_lines();
+    int fd = client_open();
+    TEST_ASSERT_TRUE(fd >= 0);
+
+    send(fd, "SCAN 12", 7, 0);
+    vTaskDelay(pdMS_TO_TICKS(5 * NET_TEST_TICK_MS));
+    TEST_ASSERT_EQUAL(0, line_count()); // nothing until the terminator
+    send(fd, "345678\r\n", 8, 0);
+    wait_lines(1);
+    TEST_ASSERT_EQUAL(1, line_count());
+    TEST_ASSERT_EQUAL_STRING("SCAN 12345678", s_lines[0]);
+    client_close(fd);
+}
+
+static void test_merged_records(void)
+{
+    reset_lines();
+    int fd = client_open();
+    TEST_ASSERT_TRUE(fd >= 0);
+
+    static const char burst[] = "A1\nB22\r\n\nC333\n";
+    send(fd, burst, sizeof(burst) - 1, 0);
+    wait_lines(3);
+    TEST_ASSERT_EQUAL(3, line_count()); // the empty record is skipped
+    TEST_ASSERT_EQUAL_STRING("A1", s_lines[0]);
+    TEST_ASSERT_EQUAL_STRING("B22", s_lines[1]);
+    TEST_ASSERT_EQUAL_STRING("C333", s_lines[2]);
+    client_close(fd);
+}
+
+static void test_long_record_dropped(void)
+{
+    net_reactor_stats_t before;
+    net_reactor_get_stats(&before);
+    reset_lines();
+    int fd = client_open();
+    TEST_ASSERT_TRUE(fd >= 0);
+
+    // longer than one NET_RX_CHUNK as well, so the drop spans several reads
+    char line[2 * NET_RX_CHUNK + 2];
+    memset(line, 'x', sizeof(line) - 1);
+    line[sizeof(line) - 1] = '\n';
+    send(fd, line, sizeof(line), 0);
+    send(fd, "NEXT\n", 5, 0);
+    wait_lines(1);
+    TEST_ASSERT_EQUAL(1, line_count());
+    TEST_ASSERT_EQUAL_STRING("NEXT", s_lines[0]);
+    TEST_ASSERT_EQUAL_UINT32(before.dropped + 1,
+                             wait_stat(offsetof(net_reactor_stats_t, dropped), before.dropped + 1, 0));
+    client_close(fd);
+}
+
+static void test_idle_client_closed(void)
+{
+    net_reactor_stats_t before;
+    net_reactor_get_stats(&before);
+    int fd = client_open();
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL_UINT32(before.accepted + 1,
+                             wait_stat(offsetof(net_reactor_stats_t, accepted), before.accepted + 1, NET_TEST_WAIT_MS));
+
+    // still open half-way through the timeout
+    vTaskDelay(pdMS_TO_TICKS(NET_TEST_IDLE_MS / 2));
+    TEST_ASSERT_EQUAL_UINT32(before.timed_out, wait_stat(offsetof(net_reactor_stats_t, timed_out), before.timed_out + 1, 0));
+
+    TEST_ASSERT_EQUAL_UINT32(before.timed_out + 1,
+                             wait_stat(offsetof(net_reactor_stats_t, timed_out), before.timed_out + 1, NET_TEST_IDLE_MS + NET_TEST_WAIT_MS));
+    char c;
+    TEST_ASSERT_EQUAL(0, recv(fd, &c, 1, 0)); // closed by the reactor
+    close(fd);
+}
+
+static void test_connection_limit(void)
+{
+    net_reactor_stats_t before;
+    net_reactor_get_stats(&before);
+    reset_lines();
+
+    // one at a time: a burst larger than NET_LISTEN_BACKLOG would wait on the host's SYN retries
+    int fds[NET_MAX_CONNS];
+    for (int i = 0; i < NET_MAX_CONNS; i++)
+    {
+        fds[i] = client_open();
+        TEST_ASSERT_TRUE(fds[i] >= 0);
+        TEST_ASSERT_EQUAL_UINT32(before.accepted + i + 1,
+                                 wait_stat(offsetof(net_reactor_stats_t, accepted), before.accepted + i + 1, NET_TEST_WAIT_MS));
+    }
+
+    // one more: the TCP handshake completes, then the reactor closes it at once
+    int extra = client_open();
+    TEST_ASSERT_TRUE(extra >= 0);
+    TEST_ASSERT_EQUAL_UINT32(before.rejected + 1,
+                             wait_stat(offsetof(net_reactor_stats_t, rejected), before.rejected + 1, NET_TEST_WAIT_MS));
+    char c;
+    TEST_ASSERT_EQUAL(0, recv(extra, &c, 1, 0));
+    close(extra);
+
+    // the accepted ones are still served
+    for (int i = 0; i < NET_MAX_CONNS; i++)
+    {
+        send(fds[i], "PING\n", 5, 0);
+    }
+    wait_lines(NET_MAX_CONNS);
+    TEST_ASSERT_EQUAL(NET_MAX_CONNS, line_count());
+
+    // a freed slot takes a new client
+    client_close(fds[0]);
+    fds[0] = client_open();
+    TEST_ASSERT_TRUE(fds[0] >= 0);
+    TEST_ASSERT_EQUAL_UINT32(before.accepted + NET_MAX_CONNS + 1,
+                             wait_stat(offsetof(net_reactor_stats_t, accepted), before.accepted + NET_MAX_CONNS + 1, NET_TEST_WAIT_MS));
+    net_reactor_stats_t after;
+    net_reactor_get_stats(&after);
+    TEST_ASSERT_EQUAL_UINT32(before.rejected + 1, after.rejected);
+
+    for (int i = 0; i < NET_MAX_CONNS; i++)
+    {
+        client_close(fds[i]);
+    }
+}
+
+/*>>> run_net_reactor_tests: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Listen on the test port, start the reactor task and run the loopback tests.
+Input: None
+Return: None
+=========================================================================================================*/
+void run_net_reactor_tests(void)
+{
+    s_lock = xSemaphoreCreateMutex();
+    if (!s_lock || net_reactor_listen(NET_TEST_PORT, NET_TEST_IDLE_MS, on_line, NULL) != ESP_OK ||
+        xTaskCreate(reactor_task, "net_reactor", 4096, NULL, 5, NULL) != pdPASS)
+    {
+        TEST_MESSAGE("reactor setup failed, skipping the reactor tests");
+        return;
+    }
+    RUN_TEST(test_split_record);
+    RUN_TEST(test_merged_records);
+    RUN_TEST(test_long_record_dropped);
+    RUN_TEST(test_idle_client_closed);
+    RUN_TEST(test_connection_limit);
+}// eo run_net_reactor_tests::
@@ -0,0 +1,112 @@
+/*======================================================================================================
+File Name:	test_scan_pipeline.c
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the host tests of the staged scan pipeline, run with the real
+allocate and render tasks. Barcodes are ingested without a connection, so no acks are sent, and
+the toasts of the render stage are counted instead of drawn.
+====================================================================================================*/
+
+#include <string.h>
+#include "unity.h"
+#include "host_tests.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "scan_pipeline.h"
+#include "view_manager.h"
+
+#define DRAIN_TIMEOUT_MS  1000
+
+static const char s_scan[] = "12345678"; // numeric barcode: always allocated
+static uint32_t   s_toasts;
+
+// The render stage draws through the view manager; only count what it is given.
+void view_toast(const lcd20x4_frame_t *frame, uint32_t ms)  { s_toasts++; }
+void view_toast_text(const char *text, uint32_t ms)         { s_toasts++; }
+
+/*>>> wait_drained: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Wait until the allocate stage has taken every queued job, and give it a tick to finish
+      the last one.
+Input: None
+Return: None
+=========================================================================================================*/
+static void wait_drained(void)
+{
+    scan_pipeline_stats_t st;
+    for (int ms = 0; ms < DRAIN_TIMEOUT_MS; ms += 10)
+    {
+        scan_pipeline_get_stats(&st);
+        if (st.alloc_depth == 0) break;
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    vTaskDelay(pdMS_TO_TICKS(10));
+}// eo wait_drained::
+
+static void test_scan_is_allocated(void)
+{
+    scan_pipeline_stats_t before, after;
+    scan_pipeline_get_stats(&before);
+    scan_pipeline_ingest(NULL, s_scan, strlen(s_scan), true);
+    wait_drained();
+    scan_pipeline_get_stats(&after);
+    TEST_ASSERT_EQUAL_UINT32(before.ingested + 1, after.ingested);
+    TEST_ASSERT_EQUAL_UINT32(before.allocated + 1, after.allocated);
+    TEST_ASSERT_EQUAL_UINT32(0, after.alloc_depth);
+}
+
+static void test_reject_burst_does_not_leak_slots(void)
+{
+    scan_pipeline_stats_t before, after;
+    scan_pipeline_get_stats(&before);
+
+    // each round fills the whole queue with rejects, so the barcode behind them is not queued;
+    // if it were still counted, SCAN_ALLOC_QUEUE_LEN rounds would leave every scan BUSY
+    for (int round = 0; round < SCAN_ALLOC_QUEUE_LEN; round++)
+    {
+        vTaskSuspendAll(); // the allocate stage cannot drain meanwhile
+        for (int i = 0; i < SCAN_ALLOC_QUEUE_LEN + SCAN_REJECT_RESERVE; i++)
+        {
+            scan_pipeline_ingest(NULL, "IDLE", 4, false);
+        }
+        scan_pipeline_ingest(NULL, s_scan, strlen(s_scan), true);
+        xTaskResumeAll();
+        wait_drained();
+    }
+    scan_pipeline_get_stats(&after);
+    TEST_ASSERT_EQUAL_UINT32(before.ack_drops + SCAN_ALLOC_QUEUE_LEN, after.ack_drops);
+    TEST_ASSERT_EQUAL_UINT32(before.ingested, after.ingested);
+
+    // a normal scan still goes through
+    before = after;
+    scan_pipeline_ingest(NULL, s_scan, strlen(s_scan), true);
+    wait_drained();
+    scan_pipeline_get_stats(&after);
+    TEST_ASSERT_EQUAL_UINT32(before.allocated + 1, after.allocated);
+    TEST_ASSERT_EQUAL_UINT32(before.alloc_drops, after.alloc_drops);
+}
+
+/*>>> run_scan_pipeline_tests: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Start the pipeline once and run its tests.
+Input: None
+Return: None
+=========================================================================================================*/
+void run_scan_pipeline_tests(void)
+{
+    shelf_manager_init();
+    if (scan_pipeline_start() != ESP_OK)
+    {
+        TEST_MESSAGE("scan_pipeline_start failed, skipping the pipeline tests");
+        return;
+    }
+    RUN_TEST(test_scan_is_allocated);
+    RUN_TEST(test_reject_burst_does_not_leak_slots);
+}// eo run_scan_pipeline_tests::
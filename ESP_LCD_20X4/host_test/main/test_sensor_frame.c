@@ -0,0 +1,278 @@
+/*======================================================================================================
+File Name:	test_sensor_frame.c
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the host tests of the binary sensor frames: round trips, every
+rejection path of the decoders, a resync stream of snapshots, deltas and CSV split into small
+pieces by the line framer, and a benchmark of one snapshot encoded and decoded against the
+same sample as the legacy CSV record (snprintf on the Transmitter, strtok/strtof on the Primary).
+Timings are reported, not asserted.
+====================================================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "unity.h"
+#include "host_tests.h"
+#include "sensor_frame.h"
+#include "line_framer.h"
+
+#define BENCH_FRAMES  200000
+#define CSV_SLOTS     10
+#define MIX_CHUNK     3   // bytes per feed: no record arrives in one piece
+#define MIX_RECORDS   4
+
+typedef struct {
+    uint8_t bytes[LINE_FRAMER_MAX + 1];
+    size_t  len;
+} mix_record_t; // One record delivered by the framer
+
+typedef struct {
+    size_t       count;
+    mix_record_t rec[MIX_RECORDS];
+} mix_log_t; // Records delivered by the framer, in order
+
+static const sensor_frame_t s_sample = {
+    .seq = 0xBEEF, .occupancy = 0x02A5, .spill = true, .temp_c = -1234, .hum_c = 4567,
+};
+
+/*>>> csv_encode: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Format a sample as the legacy "P0..P9,SPILL,TEMP,HUM" record, as the Transmitter did.
+Input: const sensor_frame_t *f - Sample.
+       char *out - Destination.
+       size_t size - Size of out.
+Return: int - Length of the record.
+=========================================================================================================*/
+static int csv_encode(const sensor_frame_t *f, char *out, size_t size)
+{
+    int off = 0;
+    for (int i = 0; i < CSV_SLOTS; i++) {
+        off += snprintf(out + off, size - off, "%d,", (f->occupancy >> i) & 1);
+    }
+    off += snprintf(out + off, size - off, "%d,", f->spill ? 1 : 0);
+    off += snprintf(out + off, size - off, "%.2f,%.2f\n", f->temp_c / 100.0f, f->hum_c / 100.0f);
+    return off;
+} // eo csv_encode::
+
+/*>>> csv_decode: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Parse a legacy CSV record the way the Primary's compatibility mode does.
+Input: char *line - Record (modified by strtok).
+       sensor_frame_t *out - Parsed sample.
+Return: None
+=========================================================================================================*/
+static void csv_decode(char *line, sensor_frame_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    char *tok = strtok(line, ",");
+    for (int i = 0; i < CSV_SLOTS && tok; i++) {
+        if (tok[0] == '1') out->occupancy |= 1u << i;
+        tok = strtok(NULL, ",");
+    }
+    if (tok) {
+        out->spill = (tok[0] == '1');
+        tok = strtok(NULL, ",");
+    }
+    float t = tok ? strtof(tok, NULL) : 0;
+    tok = strtok(NULL, ",");
+    float h = tok ? strtof(tok, NULL) : 0;
+    out->temp_c = sensor_frame_centi(t);
+    out->hum_c  = sensor_frame_centi(h);
+} // eo csv_decode::
+
+/*>>> elapsed_ns: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Time between two monotonic stamps.
+Input: const struct timespec *a / *b - Start and end.
+Return: double - Nanoseconds.
+=========================================================================================================*/
+static double elapsed_ns(const struct timespec *a, const struct timespec *b)
+{
+    return (b->tv_sec - a->tv_sec) * 1e9 + (b->tv_nsec - a->tv_nsec);
+} // eo elapsed_ns::
+
+static void test_frame_round_trip(void)
+{
+    uint8_t buf[SENSOR_FRAME_LEN];
+    sensor_frame_t f;
+    sensor_frame_encode(&s_sample, buf);
+    TEST_ASSERT_EQUAL_HEX8(SENSOR_FRAME_SYNC, buf[0]);
+    TEST_ASSERT_EQUAL(SENSOR_FRAME_OK, sensor_frame_decode(buf, sizeof(buf), &f));
+    TEST_ASSERT_EQUAL_UINT16(s_sample.seq, f.seq);
+    TEST_ASSERT_EQUAL_UINT16(s_sample.occupancy, f.occupancy);
+    TEST_ASSERT_TRUE(f.spill);
+    TEST_ASSERT_EQUAL_INT16(s_sample.temp_c, f.temp_c);
+    TEST_ASSERT_EQUAL_INT16(s_sample.hum_c, f.hum_c);
+}
+
+static void test_frame_rejects(void)
+{
+    uint8_t buf[SENSOR_FRAME_LEN];
+    sensor_frame_t f;
+    sensor_frame_encode(&s_sample, buf);
+    TEST_ASSERT_EQUAL(SENSOR_FRAME_ERR_LEN, sensor_frame_decode(buf, sizeof(buf) - 1, &f));
+
+    buf[0] = SENSOR_DELTA_SYNC;
+    TEST_ASSERT_EQUAL(SENSOR_FRAME_ERR_SYNC, sensor_frame_decode(buf, sizeof(buf), &f));
+    buf[0] = SENSOR_FRAME_SYNC;
+    buf[1] = SENSOR_FRAME_VERSION + 1;
+    TEST_ASSERT_EQUAL(SENSOR_FRAME_ERR_VERSION, sensor_frame_decode(buf, sizeof(buf), &f));
+    buf[1] = SENSOR_FRAME_VERSION;
+
+    // every single-bit error in the payload or the CRC is caught
+    for (size_t bit = 16; bit < 8 * sizeof(buf); bit++) {
+        buf[bit / 8] ^= (uint8_t)(1u << (bit % 8));
+        TEST_ASSERT_EQUAL(SENSOR_FRAME_ERR_CRC, sensor_frame_decode(buf, sizeof(buf), &f));
+        buf[bit / 8] ^= (uint8_t)(1u << (bit % 8));
+    }
+    TEST_ASSERT_EQUAL(SENSOR_FRAME_OK, sensor_frame_decode(buf, sizeof(buf), &f));
+}
+
+static void test_delta_round_trip(void)
+{
+    uint8_t buf[SENSOR_DELTA_LEN];
+    sensor_delta_t in = { .seq = 0xFFFF, .slot = 9, .occupied = true };
+    sensor_delta_t out;
+    sensor_delta_encode(&in, buf);
+    TEST_ASSERT_EQUAL(SENSOR_FRAME_OK, sensor_delta_decode(buf, sizeof(buf), &out));
+    TEST_ASSERT_EQUAL_UINT16(in.seq, out.seq);
+    TEST_ASSERT_EQUAL_UINT8(in.slot, out.slot);
+    TEST_ASSERT_TRUE(out.occupied);
+
+    TEST_ASSERT_EQUAL(SENSOR_FRAME_ERR_LEN, sensor_delta_decode(buf, SENSOR_FRAME_LEN, &out));
+    buf[3] ^= 0x01;
+    TEST_ASSERT_EQUAL(SENSOR_FRAME_ERR_CRC, sensor_delta_decode(buf, sizeof(buf), &out));
+}
+
+/*>>> mix_collect: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Line framer callback: keep the first MIX_RECORDS records and count them all.
+Input: const char *line - Record.
+       size_t len - Length of line.
+       void *ctx - The mix_log_t to append to.
+Return: None
+=========================================================================================================*/
+static void mix_collect(const char *line, size_t len, void *ctx)
+{
+    mix_log_t *log = ctx;
+    if (log->count < MIX_RECORDS)
+    {
+        memcpy(log->rec[log->count].bytes, line, len);
+        log->rec[log->count].len = len;
+    }
+    log->count++;
+}// eo mix_collect::
+
+static void test_delta_resync_stream(void)
+{
+    // what a transmitter sends across a reconnect: snapshot, deltas, and a legacy CSV record
+    static const char csv[] = "1,0,0,1,0,0,0,0,0,1,0,21.50,40.00\n";
+    sensor_frame_t snap = s_sample;
+    sensor_delta_t d1 = { .seq = 0xBEF0, .slot = 3, .occupied = true };
+    sensor_delta_t d2 = { .seq = 0xBEF1, .slot = 0, .occupied = false };
+    uint8_t stream[SENSOR_FRAME_LEN + 2 * SENSOR_DELTA_LEN + sizeof(csv)];
+    size_t n = 0;
+    sensor_frame_encode(&snap, stream + n);  n += SENSOR_FRAME_LEN;
+    sensor_delta_encode(&d1, stream + n);    n += SENSOR_DELTA_LEN;
+    memcpy(stream + n, csv, sizeof(csv) - 1); n += sizeof(csv) - 1;
+    sensor_delta_encode(&d2, stream + n);    n += SENSOR_DELTA_LEN;
+
+    line_framer_t f = { 0 };
+    TEST_ASSERT_TRUE(line_framer_set_binary(&f, SENSOR_FRAME_SYNC, SENSOR_FRAME_LEN));
+    TEST_ASSERT_TRUE(line_framer_set_binary(&f, SENSOR_DELTA_SYNC, SENSOR_DELTA_LEN));
+    line_framer_reset(&f);
+    mix_log_t got = { 0 };
+    for (size_t i = 0; i < n; i += MIX_CHUNK)
+    {
+        line_framer_feed(&f, (const char *)stream + i, (n - i < MIX_CHUNK) ? n - i : MIX_CHUNK, mix_collect, &got);
+    }
+    TEST_ASSERT_EQUAL(MIX_RECORDS, got.count);
+    TEST_ASSERT_EQUAL(0, f.dropped);
+
+    sensor_frame_t fo;
+    sensor_delta_t dout;
+    TEST_ASSERT_EQUAL(SENSOR_FRAME_OK, sensor_frame_decode(got.rec[0].bytes, got.rec[0].len, &fo));
+    TEST_ASSERT_EQUAL_UINT16(snap.occupancy, fo.occupancy);
+    TEST_ASSERT_EQUAL(SENSOR_FRAME_OK, sensor_delta_decode(got.rec[1].bytes, got.rec[1].len, &dout));
+    TEST_ASSERT_EQUAL_UINT16(snap.seq + 1, dout.seq); // one sequence for snapshots and deltas
+    TEST_ASSERT_EQUAL_UINT8(3, dout.slot);
+    TEST_ASSERT_TRUE(dout.occupied);
+    TEST_ASSERT_EQUAL(sizeof(csv) - 2, got.rec[2].len);
+    TEST_ASSERT_EQUAL_MEMORY(csv, got.rec[2].bytes, got.rec[2].len);
+    TEST_ASSERT_EQUAL(SENSOR_FRAME_OK, sensor_delta_decode(got.rec[3].bytes, got.rec[3].len, &dout));
+    TEST_ASSERT_EQUAL_UINT8(0, dout.slot);
+    TEST_ASSERT_FALSE(dout.occupied);
+}
+
+static void test_centi_rounds_and_clamps(void)
+{
+    TEST_ASSERT_EQUAL_INT16(2154, sensor_frame_centi(21.544f));
+    TEST_ASSERT_EQUAL_INT16(-1235, sensor_frame_centi(-12.346f));
+    TEST_ASSERT_EQUAL_INT16(32767, sensor_frame_centi(1000.0f));
+    TEST_ASSERT_EQUAL_INT16(-32768, sensor_frame_centi(-1000.0f));
+}
+
+static void test_frame_benchmark(void)
+{
+    static volatile uint16_t s_seq; // defeat hoisting out of the loops
+    uint8_t        buf[SENSOR_FRAME_LEN];
+    char           csv[64];
+    sensor_frame_t f = s_sample;
+    sensor_frame_t g;
+    struct timespec t0, t1, t2;
+    unsigned sink = 0;
+    int csv_len = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int k = 0; k < BENCH_FRAMES; k++) {
+        f.seq = s_seq++;
+        sensor_frame_encode(&f, buf);
+        sink += (sensor_frame_decode(buf, sizeof(buf), &g) == SENSOR_FRAME_OK) + g.seq;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for (int k = 0; k < BENCH_FRAMES; k++) {
+        f.occupancy = s_seq++ & 0x3FF;
+        csv_len = csv_encode(&f, csv, sizeof(csv));
+        csv_decode(csv, &g);
+        sink += g.occupancy;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+
+    double ns_bin = elapsed_ns(&t0, &t1) / BENCH_FRAMES;
+    double ns_csv = elapsed_ns(&t1, &t2) / BENCH_FRAMES;
+    printf("sensor_frame bench: binary %d B %.0f ns/frame, CSV %d B %.0f ns/frame (x%.1f)\n",
+           SENSOR_FRAME_LEN, ns_bin, csv_len, ns_csv, ns_csv / ns_bin);
+    TEST_ASSERT_GREATER_THAN(0, sink);
+    TEST_ASSERT_LESS_THAN(csv_len, SENSOR_FRAME_LEN);
+}
+
+/*>>> run_sensor_frame_tests: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Run the frame tests and the benchmark.
+Input: None
+Return: None
+=========================================================================================================*/
+void run_sensor_frame_tests(void)
+{
+    RUN_TEST(test_frame_round_trip);
+    RUN_TEST(test_frame_rejects);
+    RUN_TEST(test_delta_round_trip);
+    RUN_TEST(test_delta_resync_stream);
+    RUN_TEST(test_centi_rounds_and_clamps);
+    RUN_TEST(test_frame_benchmark);
+} // eo run_sensor_frame_tests::
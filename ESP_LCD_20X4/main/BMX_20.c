@@ -2,7 +2,7 @@
 File Name:	BMX_20.c
 Author:		Vraj Patel, Samip Patel
 Date:		10/07/2025
-Modified:	None
+Modified:	17/10/2026
 © Fanshawe College, 2025
 
 Description: This file contains the implementation of the BMX-20 sensor driver,
@@ -14,68 +14,113 @@ including initialization, configuration, and data reading functions.
 #include "BMX_20.h"
 #include "esp_log.h"
 #include "freertos/task.h"
+#include "esp_attr.h"
 #include "esp_rom_sys.h"
+#include "esp_timer.h"
 
 static const char *TAG = "BMX20";
 
 // --- low‑level I2C helpers ----------------------------------------------------
 
+/*>>> bmx20_on_trans_done: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This ISR callback runs when a queued transfer to either sensor
+			finishes and wakes the task waiting in bmx20_xfer().
+Input: 		- i2c_dev: Device handle (unused)
+			- evt: Completion event
+			- arg: Pointer to the BMX-20 device structure
+Returns:	true if a higher-priority task was woken.
+ ============================================================================*/
+static bool IRAM_ATTR bmx20_on_trans_done(i2c_master_dev_handle_t i2c_dev, const i2c_master_event_data_t *evt, void *arg)
+{
+    bmx20_t *dev = arg;
+    BaseType_t woken = pdFALSE;
+    dev->xfer_err = (evt->event == I2C_EVENT_DONE) ? ESP_OK : ESP_FAIL;
+    xSemaphoreGiveFromISR(dev->xfer_done, &woken);
+    return woken == pdTRUE;
+}// eo bmx20_on_trans_done::
+
+/*>>> bmx20_xfer: ==========================================================
+Author:		Vraj Patel, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will run one write or write+read transaction on a
+			sensor and wait for it, whether the bus is synchronous or queued.
+			Nothing is allocated per call. The buffers are the caller's (often
+			on its stack), so a queued transfer whose completion is late is
+			waited for by draining the bus before returning; a stale completion
+			is cleared before queueing so it cannot answer the next transfer.
+Input: 		- dev: Pointer to the BMX-20 device structure
+			- i2c_dev: Sensor device handle
+			- tx: Bytes to write
+			- tx_len: Number of bytes to write
+			- rx: Buffer for the read phase, or NULL for a write only
+			- rx_len: Number of bytes to read
+Returns:	ESP_OK on success, or an error code on failure.
+ ============================================================================*/
+static esp_err_t bmx20_xfer(bmx20_t *dev, i2c_master_dev_handle_t i2c_dev,
+                            const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len)
+{
+    int64_t t0 = esp_timer_get_time();
+    if (dev->async) {
+        xSemaphoreTake(dev->xfer_done, 0); // completion of an earlier, abandoned transfer
+    }
+    esp_err_t err = rx
+        ? i2c_master_transmit_receive(i2c_dev, tx, tx_len, rx, rx_len, BMX20_I2C_TIMEOUT_MS)
+        : i2c_master_transmit(i2c_dev, tx, tx_len, BMX20_I2C_TIMEOUT_MS);
+    if (err == ESP_OK && dev->async) {
+        // queued: buffers must stay valid until the callback fires
+        if (xSemaphoreTake(dev->xfer_done, pdMS_TO_TICKS(BMX20_I2C_TIMEOUT_MS)) == pdTRUE) {
+            err = dev->xfer_err;
+        } else {
+            // the callback runs before the bus reports idle, so once the queue is
+            // empty the transfer is off the caller's buffers and its completion given
+            i2c_master_bus_wait_all_done(dev->bus, -1);
+            err = (xSemaphoreTake(dev->xfer_done, 0) == pdTRUE) ? dev->xfer_err : ESP_ERR_TIMEOUT;
+        }
+    }
+    dev->transactions++;
+    dev->bus_time_us += (uint32_t)(esp_timer_get_time() - t0);
+    return err;
+}// eo bmx20_xfer::
+
 /*>>> i2c_write_reg: ==========================================================
 Author:		Vraj Patel, Samip Patel
 Date:		10/07/2025
-Modified:	None
+Modified:	17/10/2026
 Desc:		This function will write a single byte to a specific register of an I2C device.
-Input: 		- port: I2C port number
-			- addr: I2C device address
+Input: 		- dev: Pointer to the BMX-20 device structure
+			- i2c_dev: Sensor device handle
 			- reg: Register address to write to
 			- data: Data byte to write
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
 
-static esp_err_t i2c_write_reg(i2c_port_t port, uint8_t addr, uint8_t reg, uint8_t data)
+static esp_err_t i2c_write_reg(bmx20_t *dev, i2c_master_dev_handle_t i2c_dev, uint8_t reg, uint8_t data)
 {
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-      i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_WRITE, true);
-      i2c_master_write_byte(cmd, reg, true);
-      i2c_master_write_byte(cmd, data, true);
-    i2c_master_stop(cmd);
-    esp_err_t err = i2c_master_cmd_begin(port, cmd, pdMS_TO_TICKS(100));
-    i2c_cmd_link_delete(cmd);
-    return err;
+    const uint8_t buf[2] = { reg, data };
+    return bmx20_xfer(dev, i2c_dev, buf, sizeof(buf), NULL, 0);
 }// eo i2c_write_reg::
 
 /*>>> i2c_read_bytes: ==========================================================
 Author:		Vraj Patel, Samip Patel
 Date:		10/07/2025
-Modified:	None
+Modified:	17/10/2026
 Desc:		This function will read multiple bytes from a specific register of an I2C device.
-Input: 		- port: I2C port number
-			- addr: I2C device address
+Input: 		- dev: Pointer to the BMX-20 device structure
+			- i2c_dev: Sensor device handle
 			- reg: Register address to read from
 			- buf: Buffer to store the read data
 			- len: Number of bytes to read
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
 
-static esp_err_t i2c_read_bytes(i2c_port_t port, uint8_t addr, uint8_t reg, uint8_t *buf, size_t len)
+static esp_err_t i2c_read_bytes(bmx20_t *dev, i2c_master_dev_handle_t i2c_dev, uint8_t reg, uint8_t *buf, size_t len)
 {
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    // set register pointer
-    i2c_master_start(cmd);
-      i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_WRITE, true);
-      i2c_master_write_byte(cmd, reg, true);
-    // read data back
-    i2c_master_start(cmd);
-      i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_READ, true);
-      if (len > 1) {
-          i2c_master_read(cmd, buf, len - 1, I2C_MASTER_ACK);
-      }
-      i2c_master_read_byte(cmd, buf + len - 1, I2C_MASTER_NACK);
-    i2c_master_stop(cmd);
-    esp_err_t err = i2c_master_cmd_begin(port, cmd, pdMS_TO_TICKS(100));
-    i2c_cmd_link_delete(cmd);
-    return err;
+    // set register pointer, then repeated start and read data back
+    return bmx20_xfer(dev, i2c_dev, &reg, 1, buf, len);
 }// eo i2c_read_bytes::
 
 /*>>> bmp280_init: ==========================================================
@@ -91,7 +136,7 @@ static esp_err_t bmp280_init(bmx20_t *dev)
 {
     uint8_t calib[6];
     // Read T1,T2,T3 calibration registers (0x88..0x8D)
-    esp_err_t err = i2c_read_bytes(dev->port, dev->addr_bmp280, 0x88, calib, sizeof(calib));
+    esp_err_t err = i2c_read_bytes(dev, dev->bmp280, 0x88, calib, sizeof(calib));
     if (err) {
         ESP_LOGE(TAG, "BMP280 cal read failed");
         return err;
@@ -101,7 +146,7 @@ static esp_err_t bmp280_init(bmx20_t *dev)
     dev->dig_T3 = (int16_t)(calib[4] | (calib[5] << 8));
 
     // Configure: osrs_t = 1 (<<5), osrs_p = 0, mode = Normal (3)
-    return i2c_write_reg(dev->port, dev->addr_bmp280, 0xF4, (1 << 5) | 3);
+    return i2c_write_reg(dev, dev->bmp280, 0xF4, (1 << 5) | 3);
 }// eo bmp280_init::
 
 /*>>> bmx20_read_temperature: ==========================================================
@@ -117,7 +162,7 @@ Returns:	ESP_OK on success, or an error code on failure.
 esp_err_t bmx20_read_temperature(bmx20_t *dev, float *temperature)
 {
     uint8_t data[3];
-    esp_err_t err = i2c_read_bytes(dev->port, dev->addr_bmp280, 0xFA, data, sizeof(data));
+    esp_err_t err = i2c_read_bytes(dev, dev->bmp280, 0xFA, data, sizeof(data));
     if (err) return err;
 
     int32_t adc_T = ((int32_t)data[0] << 12) | ((int32_t)data[1] << 4) | (data[2] >> 4);
@@ -143,14 +188,7 @@ Returns:	ESP_OK on success, or an error code on failure.
 static esp_err_t aht20_trigger_measure(bmx20_t *dev)
 {
     const uint8_t cmd[3] = { 0xAC, 0x33, 0x00 };
-    i2c_cmd_handle_t c = i2c_cmd_link_create();
-    i2c_master_start(c);
-      i2c_master_write_byte(c, (dev->addr_aht20 << 1) | I2C_MASTER_WRITE, true);
-      i2c_master_write(c, (uint8_t *)cmd, sizeof(cmd), true);
-    i2c_master_stop(c);
-    esp_err_t err = i2c_master_cmd_begin(dev->port, c, pdMS_TO_TICKS(100));
-    i2c_cmd_link_delete(c);
-    return err;
+    return bmx20_xfer(dev, dev->aht20, cmd, sizeof(cmd), NULL, 0);
 }// eo aht20_trigger_measure::
 
 /*>>> bmx20_read_humidity: ==========================================================
@@ -171,7 +209,7 @@ esp_err_t bmx20_read_humidity(bmx20_t *dev, float *humidity)
     esp_rom_delay_us(80000);
 
     uint8_t buf[6];
-    err = i2c_read_bytes(dev->port, dev->addr_aht20, 0x00, buf, sizeof(buf));
+    err = i2c_read_bytes(dev, dev->aht20, 0x00, buf, sizeof(buf));
     if (err) return err;
 
     uint32_t raw_h = ((uint32_t)(buf[1] & 0x0F) << 16)
@@ -186,28 +224,44 @@ esp_err_t bmx20_read_humidity(bmx20_t *dev, float *humidity)
 /*>>> bmx20_init: ==========================================================
 Author:		Vraj Patel, Samip Patel
 Date:		10/07/2025
-Modified:	None
-Desc:		This function will initialize the BMX-20 device by setting up
-			the I2C communication and initializing the connected sensors.
+Modified:	17/10/2026
+Desc:		This function will initialize the BMX-20 device by attaching both
+			sensors to the shared I2C bus and initializing them.
 Input: 		- dev: Pointer to the BMX-20 device structure
-			- port: I2C port number
-			- sda_gpio: GPIO number for I2C SDA
-			- scl_gpio: GPIO number for I2C SCL
+			- bus: Shared I2C master bus handle
+			- clk_speed: SCL speed for both sensors in Hz
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
 esp_err_t bmx20_init(bmx20_t *dev,
-                     i2c_port_t port,
-                     gpio_num_t sda_gpio,
-                     gpio_num_t scl_gpio,
+                     i2c_master_bus_handle_t bus,
                      uint32_t clk_speed)
 {
-    // CHANGE: removed bus setup here; I2C is already configured once in main.c
-    dev->port        = port;
-    dev->addr_aht20  = AHT20_I2C_ADDR;
-    dev->addr_bmp280 = BMP280_I2C_ADDR;
+    // The bus itself is created once in main.c and shared with the LCD
+    dev->bus          = bus;
+    dev->addr_aht20   = AHT20_I2C_ADDR;
+    dev->addr_bmp280  = BMP280_I2C_ADDR;
+    dev->transactions = 0;
+    dev->bus_time_us  = 0;
+
+    i2c_device_config_t cfg = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .scl_speed_hz    = clk_speed,
+    };
+    cfg.device_address = dev->addr_aht20;
+    esp_err_t err = i2c_master_bus_add_device(bus, &cfg, &dev->aht20);
+    if (err) return err;
+    cfg.device_address = dev->addr_bmp280;
+    err = i2c_master_bus_add_device(bus, &cfg, &dev->bmp280);
+    if (err) return err;
+
+    // completion callbacks are only accepted on an asynchronous bus
+    dev->xfer_done = xSemaphoreCreateBinaryStatic(&dev->xfer_done_buf);
+    i2c_master_event_callbacks_t cbs = { .on_trans_done = bmx20_on_trans_done };
+    dev->async = (i2c_master_register_event_callbacks(dev->aht20, &cbs, dev) == ESP_OK)
+              && (i2c_master_register_event_callbacks(dev->bmp280, &cbs, dev) == ESP_OK);
 
     // Initialize BMP280 (reads calibration + sets control register)
-    esp_err_t err = bmp280_init(dev);
+    err = bmp280_init(dev);
     if (err) {
         ESP_LOGE(TAG, "BMP280 init failed");
         return err;
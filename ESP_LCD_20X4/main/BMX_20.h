@@ -2,7 +2,7 @@
 File Name:	BMX_20.h
 Author:		Vraj Patel, Samip Patel
 Date:		10/07/2025
-Modified:	None
+Modified:	17/10/2026
 © Fanshawe College, 2025
 
 Description: This file contains the definition of the BMX-20 sensor driver,
@@ -14,9 +14,11 @@ including data structures and function prototypes.
 #define BMX_20_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "esp_err.h"
-#include "driver/i2c.h"
-#include "driver/gpio.h"
+#include "driver/i2c_master.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,8 +27,12 @@ extern "C" {
 #define AHT20_I2C_ADDR    0x38
 #define BMP280_I2C_ADDR   0x77
 
+#define BMX20_I2C_TIMEOUT_MS  100 // Per-transfer timeout
+
 typedef struct {
-    i2c_port_t port;
+    i2c_master_bus_handle_t bus;     // shared bus, drained when a completion is late
+    i2c_master_dev_handle_t aht20;   // AHT20 on the shared bus
+    i2c_master_dev_handle_t bmp280;  // BMP280 on the shared bus
     uint8_t    addr_aht20;
     uint8_t    addr_bmp280;
     // BMP280 calibration params:
@@ -34,21 +40,25 @@ typedef struct {
     int16_t    dig_T2;
     int16_t    dig_T3;
     int32_t    t_fine;
+    // bus accounting (for before/after comparisons)
+    uint32_t   transactions;  // I2C transactions issued
+    uint32_t   bus_time_us;   // submit-to-completion time of those transactions
+    // asynchronous transfer state (bus created with trans_queue_depth > 0)
+    bool               async;
+    volatile esp_err_t xfer_err;
+    SemaphoreHandle_t  xfer_done;
+    StaticSemaphore_t  xfer_done_buf;
 } bmx20_t;
 
 /**
- * @brief Initialize I2C peripheral and both sensors.
+ * @brief Attach both sensors to an already created I2C master bus.
  * @param dev         Pointer to your bmx20_t struct
- * @param port        I2C_NUM_0 or I2C_NUM_1
- * @param sda_gpio    GPIO_NUM_x for SDA line
- * @param scl_gpio    GPIO_NUM_x for SCL line
+ * @param bus         Shared bus from i2c_new_master_bus()
  * @param clk_speed   e.g. 100000 (100 kHz)
  * @return ESP_OK on success
  */
 esp_err_t bmx20_init(bmx20_t *dev,
-                     i2c_port_t port,
-                     gpio_num_t sda_gpio,
-                     gpio_num_t scl_gpio,
+                     i2c_master_bus_handle_t bus,
                      uint32_t clk_speed);
 
 /**
@@ -0,0 +1,198 @@
+/*======================================================================================================
+File Name:	buttons.c
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the implementation of the interrupt-driven push buttons. The ISR
+only restarts the button's debounce timer, so contact bounce keeps pushing the sample point out
+until the pin has been quiet for BUTTON_DEBOUNCE_MS. The timer callback (FreeRTOS timer task) then
+reads the settled level, posts press or release, and arms a second timer for the long press.
+====================================================================================================*/
+
+#include "buttons.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/timers.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+
+static const char *TAG = "BUTTONS";
+
+typedef struct {
+    gpio_num_t    gpio;
+    uint8_t       index;
+    bool          pressed;    // debounced state
+    TimerHandle_t debounce;   // restarted by every edge
+    TimerHandle_t hold;       // long-press timer
+} button_t; // One debounced button
+
+static button_t      s_buttons[BUTTONS_MAX];
+static size_t        s_count;
+static QueueHandle_t s_events;
+
+/*>>> post_event: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Queue an event without blocking the timer task; events are dropped if nobody is consuming.
+Input: const button_t *b - Button.
+       button_event_type_t type - Event.
+Return: None
+=========================================================================================================*/
+static void post_event(const button_t *b, button_event_type_t type)
+{
+    button_event_t ev = { .button = b->index, .type = type };
+    if (xQueueSend(s_events, &ev, 0) != pdTRUE)
+    {
+        ESP_LOGW(TAG, "Event queue full, dropping button %u event %d", b->index, type);
+    }
+}// eo post_event::
+
+/*>>> button_isr: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: GPIO any-edge interrupt: (re)start the debounce timer.
+Input: void *arg - Button.
+Return: None
+=========================================================================================================*/
+static void IRAM_ATTR button_isr(void *arg)
+{
+    button_t  *b    = arg;
+    BaseType_t woke = pdFALSE;
+    xTimerResetFromISR(b->debounce, &woke);
+    portYIELD_FROM_ISR(woke);
+}// eo button_isr::
+
+/*>>> debounce_expired: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Timer callback: the pin has settled; post a press or release if its state changed.
+Input: TimerHandle_t t - Debounce timer (ID is the button).
+Return: None
+=========================================================================================================*/
+static void debounce_expired(TimerHandle_t t)
+{
+    button_t *b       = pvTimerGetTimerID(t);
+    bool      pressed = gpio_get_level(b->gpio) == 0; // active low
+    if (pressed == b->pressed)
+    {
+        return; // bounced back to where it was
+    }
+    b->pressed = pressed;
+    if (pressed)
+    {
+        xTimerReset(b->hold, 0);
+        post_event(b, BUTTON_PRESS);
+    }
+    else
+    {
+        xTimerStop(b->hold, 0);
+        post_event(b, BUTTON_RELEASE);
+    }
+}// eo debounce_expired::
+
+/*>>> hold_expired: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Timer callback: the button has been held for BUTTON_LONG_MS.
+Input: TimerHandle_t t - Hold timer (ID is the button).
+Return: None
+=========================================================================================================*/
+static void hold_expired(TimerHandle_t t)
+{
+    button_t *b = pvTimerGetTimerID(t);
+    if (b->pressed)
+    {
+        post_event(b, BUTTON_LONG_PRESS);
+    }
+}// eo hold_expired::
+
+/*>>> buttons_init: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Configure the button pins, their timers and interrupts, and the event queue.
+Input: const gpio_num_t *gpios - Button pins.
+       size_t count - Number of pins.
+Return: esp_err_t - ESP_OK, ESP_ERR_INVALID_ARG or ESP_ERR_NO_MEM, or a GPIO driver error.
+=========================================================================================================*/
+esp_err_t buttons_init(const gpio_num_t *gpios, size_t count)
+{
+    if (count == 0 || count > BUTTONS_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_events = xQueueCreate(BUTTON_QUEUE_LEN, sizeof(button_event_t));
+    if (!s_events)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    uint64_t mask = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        mask |= 1ULL << gpios[i];
+    }
+    gpio_config_t cfg =
+    {
+        .pin_bit_mask = mask,
+        .mode         = GPIO_MODE_INPUT,
+        .pull_up_en   = GPIO_PULLUP_ENABLE,
+        .intr_type    = GPIO_INTR_ANYEDGE,
+    };
+    esp_err_t err = gpio_config(&cfg);
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+    err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) // already installed by someone else
+    {
+        return err;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        button_t *b = &s_buttons[i];
+        b->gpio     = gpios[i];
+        b->index    = i;
+        b->pressed  = gpio_get_level(b->gpio) == 0;
+        b->debounce = xTimerCreate("btn_db", pdMS_TO_TICKS(BUTTON_DEBOUNCE_MS), pdFALSE, b, debounce_expired);
+        b->hold     = xTimerCreate("btn_hold", pdMS_TO_TICKS(BUTTON_LONG_MS), pdFALSE, b, hold_expired);
+        if (!b->debounce || !b->hold)
+        {
+            return ESP_ERR_NO_MEM;
+        }
+        err = gpio_isr_handler_add(b->gpio, button_isr, b);
+        if (err != ESP_OK)
+        {
+            return err;
+        }
+    }
+    s_count = count;
+    return ESP_OK;
+}// eo buttons_init::
+
+/*>>> buttons_wait: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Block until the next button event or the timeout.
+Input: button_event_t *ev - Receives the event.
+       uint32_t timeout_ms - Longest wait, UINT32_MAX for no limit.
+Return: bool - true if an event was received.
+=========================================================================================================*/
+bool buttons_wait(button_event_t *ev, uint32_t timeout_ms)
+{
+    if (!s_count)
+    {
+        return false;
+    }
+    TickType_t ticks = (timeout_ms == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    return xQueueReceive(s_events, ev, ticks) == pdTRUE;
+}// eo buttons_wait::
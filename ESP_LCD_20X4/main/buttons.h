@@ -0,0 +1,49 @@
+/*======================================================================================================
+File Name:	buttons.h
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the interface for the interrupt-driven push buttons. Each button
+raises a GPIO interrupt on any edge; a FreeRTOS software timer debounces it and the result is posted
+to an event queue as press, long-press and release events, so no task has to poll the pins.
+====================================================================================================*/
+
+#ifndef BUTTONS_H
+#define BUTTONS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "driver/gpio.h"
+
+#define BUTTONS_MAX         4    // Buttons supported by buttons_init()
+#define BUTTON_DEBOUNCE_MS  30   // Pin must be quiet this long before it is sampled
+#define BUTTON_LONG_MS      1000 // Held this long → BUTTON_LONG_PRESS
+#define BUTTON_QUEUE_LEN    8    // Events waiting for the consumer
+
+typedef enum {
+    BUTTON_PRESS,       // debounced press
+    BUTTON_LONG_PRESS,  // still held after BUTTON_LONG_MS
+    BUTTON_RELEASE,     // debounced release
+} button_event_type_t;
+
+typedef struct {
+    uint8_t             button; // index into the gpios passed to buttons_init()
+    button_event_type_t type;
+} button_event_t; // One button event
+
+/**
+ * @brief Configure active-low buttons (internal pull-up) with any-edge
+ *        interrupts and start debouncing them.
+ * @param gpios  Button pins; event `button` fields index this array
+ * @param count  Number of pins (≤ BUTTONS_MAX)
+ */
+esp_err_t buttons_init(const gpio_num_t *gpios, size_t count);
+
+/// Wait up to `timeout_ms` (UINT32_MAX = forever) for the next event.
+bool buttons_wait(button_event_t *ev, uint32_t timeout_ms);
+
+#endif // BUTTONS_H
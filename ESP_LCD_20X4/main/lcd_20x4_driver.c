@@ -2,7 +2,7 @@
 File Name:	lcd_20x4_driver.c
 Author:		Vamseedhar Reddy, Samip Patel
 Date:		10/07/2025
-Modified:	None
+Modified:	17/10/2026
 © Fanshawe College, 2025
 
 Description: This file contains the implementation of the LCD 20x4 driver,
@@ -13,51 +13,126 @@ including functions for initializing and controlling the display.
 
 #include "lcd_20x4_driver.h"
 #include <string.h>
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
-#include "driver/i2c.h"
-#include "esp_rom_sys.h"
+#include <math.h>
 
-// Low‐level I²C write
+// Low‐level transport write
 
-/*>>> _i2c_write_byte: ==========================================================
+/*>>> _io_wait: ==========================================================
 Author:		Vamseedhar Reddy, Samip Patel
-Date:		10/07/2025
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will block until the in-flight transfer (if any) has
+			left the bus, so the burst buffer may be reused.
+Input: 		- lcd: Pointer to the LCD driver structure
+Returns:	Result of the in-flight transfer, ESP_OK if there was none.
+ ============================================================================*/
+static esp_err_t _io_wait(lcd_20x4_driver_t *lcd) {
+    return lcd->io->wait(lcd->io);
+}// eo _io_wait::
+
+/*>>> _defer: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will record that the HD44780 is busy for the given
+			time from now. Nothing waits here; the next transfer to this LCD
+			does, so the caller and other devices on the bus keep running.
+Input: 		- lcd: Pointer to the LCD driver structure
+			- us: Execution time of the command just sent
+Returns:	None
+ ============================================================================*/
+static void _defer(lcd_20x4_driver_t *lcd, uint32_t us) {
+    lcd->ready_at_us = lcd->io->now_us(lcd->io) + us;
+}// eo _defer::
+
+/*>>> _io_submit: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
 Modified:	None
-Desc:		This function will write a single byte to the I²C device.
+Desc:		This function will hand a burst of bytes to the transport as a
+			single transaction, once the previous one has finished and the
+			deadline set by _defer() has passed. The transport may return
+			before the bytes are on the wire; `data` must then stay untouched
+			until _io_wait() returns.
 Input: 		- lcd: Pointer to the LCD driver structure
-			- data: The byte data to write
+			- data: The bytes to write
+			- len: Number of bytes
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
-static esp_err_t _i2c_write_byte(lcd_20x4_driver_t *lcd, uint8_t data) {
-    return i2c_master_write_to_device(lcd->port, lcd->address, &data, 1, pdMS_TO_TICKS(100));
-}// eo _i2c_write_byte::
+static esp_err_t _io_submit(lcd_20x4_driver_t *lcd, const uint8_t *data, size_t len) {
+    esp_err_t err = _io_wait(lcd);
+    if (err != ESP_OK) return err;
+    lcd->io->sleep_until(lcd->io, lcd->ready_at_us);
+    lcd->stats.bytes += len;
+    lcd->stats.transactions++;
+    return lcd->io->transmit(lcd->io, data, len);
+}// eo _io_submit::
 
-// Pulse the enable bit
-/*>>> _strobe: ==========================================================
+/*>>> _io_write: ==========================================================
 Author:		Vamseedhar Reddy, Samip Patel
 Date:		10/07/2025
-Modified:	None
-Desc:		This function will pulse the enable pin on the LCD.
+Modified:	17/10/2026
+Desc:		This function will write a burst of bytes to the PCF8574 and wait
+			for it to complete (used for commands and stack buffers).
 Input: 		- lcd: Pointer to the LCD driver structure
-			- data: The data to send
+			- data: The bytes to write
+			- len: Number of bytes
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
-static esp_err_t _strobe(lcd_20x4_driver_t *lcd, uint8_t data) {
-    // EN_BIT high
-    _i2c_write_byte(lcd, data | EN_BIT | (lcd->backlight ? BL_BIT : 0));
-    esp_rom_delay_us(LCD_DELAY_ENABLE_PULSE_US);
-    // EN_BIT low
-    _i2c_write_byte(lcd, data           | (lcd->backlight ? BL_BIT : 0));
-    esp_rom_delay_us(LCD_DELAY_ENABLE_SETTLE_US);
-    return ESP_OK;
-}// eo _strobe::
+static esp_err_t _io_write(lcd_20x4_driver_t *lcd, const uint8_t *data, size_t len) {
+    esp_err_t err = _io_submit(lcd, data, len);
+    if (err != ESP_OK) return err;
+    return _io_wait(lcd);
+}// eo _io_write::
+
+// Encode 4 bits + RS + backlight with its enable strobe
+/*>>> _encode_nibble: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will encode a 4-bit nibble as the three expander states
+			that clock it into the LCD: data, data|EN, data. At 100 kHz each
+			expander byte takes ~90 µs on the wire, which already covers the
+			enable pulse width and the 37 µs HD44780 execution time, so no
+			software delay is needed between nibbles.
+Input: 		- lcd: Pointer to the LCD driver structure
+			- out: Where to store the LCD_BYTES_PER_NIBBLE encoded bytes
+			- nibble: The 4-bit nibble to encode
+			- rs: Register select flag (true for data, false for command)
+Returns:	Number of bytes written to out.
+ ============================================================================*/
+static size_t _encode_nibble(const lcd_20x4_driver_t *lcd, uint8_t *out, uint8_t nibble, bool rs) {
+    uint8_t cmd = (nibble & 0x0F) << 4;
+    if (rs)            cmd |= RS_BIT;
+    if (lcd->backlight) cmd |= BL_BIT;
+    out[0] = cmd;           // set up data
+    out[1] = cmd | EN_BIT;  // EN_BIT high
+    out[2] = cmd;           // EN_BIT low, LCD latches the nibble
+    return LCD_BYTES_PER_NIBBLE;
+}// eo _encode_nibble::
+
+// Encode full byte as two nibbles
+/*>>> _encode_byte: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will encode a full byte as two nibbles.
+Input: 		- lcd: Pointer to the LCD driver structure
+			- out: Where to store the LCD_BYTES_PER_CHAR encoded bytes
+			- val: The byte value to encode
+			- rs: Register select flag (true for data, false for command)
+Returns:	Number of bytes written to out.
+ ============================================================================*/
+static size_t _encode_byte(const lcd_20x4_driver_t *lcd, uint8_t *out, uint8_t val, bool rs) {
+    size_t n = _encode_nibble(lcd, out, val >> 4, rs);
+    return n + _encode_nibble(lcd, out + n, val & 0x0F, rs);
+}// eo _encode_byte::
 
 // Write 4 bits + RS + backlight
 /*>>> _write_nibble: ==========================================================
 Author:		Vamseedhar Reddy, Samip Patel
 Date:		10/07/2025
-Modified:	None
+Modified:	17/10/2026
 Desc:		This function will write a 4-bit nibble to the LCD.
 Input: 		- lcd: Pointer to the LCD driver structure
 			- nibble: The 4-bit nibble to write
@@ -65,114 +140,134 @@ Input: 		- lcd: Pointer to the LCD driver structure
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
 static esp_err_t _write_nibble(lcd_20x4_driver_t *lcd, uint8_t nibble, bool rs) {
-    uint8_t cmd = (nibble & 0x0F) << 4;
-    if (rs)            cmd |= RS_BIT;
-    if (lcd->backlight) cmd |= BL_BIT;
-    _i2c_write_byte(lcd, cmd);
-    return _strobe(lcd, cmd);
+    uint8_t buf[LCD_BYTES_PER_NIBBLE];
+    return _io_write(lcd, buf, _encode_nibble(lcd, buf, nibble, rs));
 }// eo _write_nibble::
 
 // Write full byte as two nibbles
 /*>>> _write_byte: ==========================================================
 Author:		Vamseedhar Reddy, Samip Patel
 Date:		10/07/2025
-Modified:	None
-Desc:		This function will write a full byte to the LCD.
+Modified:	17/10/2026
+Desc:		This function will write a full byte to the LCD in one transaction.
 Input: 		- lcd: Pointer to the LCD driver structure
 			- val: The byte value to write
 			- rs: Register select flag (true for data, false for command)
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
 static esp_err_t _write_byte(lcd_20x4_driver_t *lcd, uint8_t val, bool rs) {
-    _write_nibble(lcd, val >> 4, rs);
-    return _write_nibble(lcd, val & 0x0F, rs);
+    uint8_t buf[LCD_BYTES_PER_CHAR];
+    return _io_write(lcd, buf, _encode_byte(lcd, buf, val, rs));
 }
 
+/*>>> _encode_run: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will encode a DDRAM address followed by a run of
+			characters as a PCF8574 byte stream.
+Input: 		- lcd: Pointer to the LCD driver structure
+			- out: Where to store the encoded bytes
+			- addr: DDRAM address of the first character
+			- chars: The characters to write
+			- len: Number of characters
+Returns:	Number of bytes written to out.
+ ============================================================================*/
+static size_t _encode_run(const lcd_20x4_driver_t *lcd, uint8_t *out, uint8_t addr, const char *chars, size_t len) {
+    size_t n = _encode_byte(lcd, out, CMD_SET_DDRAM_ADDR | (addr & 0x7F), false);
+    for (size_t i = 0; i < len; i++) {
+        n += _encode_byte(lcd, out + n, (uint8_t)chars[i], true);
+    }
+    return n;
+}// eo _encode_run::
+
 // Public API
 
-/*>>> lcd20x4_init: ==========================================================
+/*>>> lcd20x4_init_io: ==========================================================
 Author:		Vamseedhar Reddy, Samip Patel
 Date:		10/07/2025
-Modified:	None
-Desc:		This function will initialize the LCD driver.
+Modified:	17/10/2026
+Desc:		This function will initialize the LCD driver on top of a transport.
+			The power-on and init-sequence delays are deadlines honoured by the
+			transport rather than spins.
 Input: 		- lcd: Pointer to the LCD driver structure
-			- i2c_port: I²C port number
-			- sda_gpio: SDA GPIO pin number
-			- scl_gpio: SCL GPIO pin number
-Returns:	ESP_OK on success, or an error code on failure.
+			- io: Transport to write through
+			- backlight: true=on, false=off
+			- rows, cols: Panel geometry
+Returns:	ESP_OK on success, or the first error of the init sequence.
  ============================================================================*/
-esp_err_t lcd20x4_init(lcd_20x4_driver_t *lcd,
-                       i2c_port_t i2c_port,
-                       gpio_num_t sda_gpio,
-                       gpio_num_t scl_gpio,
-                       uint32_t clk_speed,
-                       uint8_t lcd_addr,
-                       bool backlight,
-                       uint8_t rows,
-                       uint8_t cols)
+esp_err_t lcd20x4_init_io(lcd_20x4_driver_t *lcd,
+                          lcd20x4_transport_t *io,
+                          bool backlight,
+                          uint8_t rows,
+                          uint8_t cols)
 {
-    lcd->port      = i2c_port;
-    lcd->address   = lcd_addr;
+    lcd->io        = io;
     lcd->backlight = backlight;
-    lcd->rows      = rows;
-    lcd->cols      = cols;
-
-    i2c_config_t cfg = {
-        .mode = I2C_MODE_MASTER,
-        .sda_io_num = sda_gpio,
-        .scl_io_num = scl_gpio,
-        .master.clk_speed = clk_speed,
-    };
-    i2c_param_config(i2c_port, &cfg);
-    i2c_driver_install(i2c_port, cfg.mode, 0, 0, 0);
-
-    esp_rom_delay_us(LCD_DELAY_POWER_ON_US);
-
-    // 4‑bit init sequence
-    _write_nibble(lcd, 0x03, false);
-    esp_rom_delay_us(LCD_DELAY_INIT1_US);
-    _write_nibble(lcd, 0x03, false);
-    esp_rom_delay_us(LCD_DELAY_INIT2_US);
-    _write_nibble(lcd, 0x03, false);
-    esp_rom_delay_us(LCD_DELAY_INIT3_US);
-    _write_nibble(lcd, 0x02, false);
+    lcd->rows      = (rows > LCD_ROWS_MAX) ? LCD_ROWS_MAX : rows;
+    lcd->cols      = (cols > LCD_COLS_MAX) ? LCD_COLS_MAX : cols;
+    lcd20x4_reset_stats(lcd);
+    lcd20x4_fb_clear(lcd);
+
+    lcd->ready_at_us = 0;
+    lcd20x4_set_glyph_table(lcd, NULL, 0);
+
+    // every wait below is a deadline honoured by the next transfer, which
+    // blocks the calling task instead of spinning the CPU
+    _defer(lcd, LCD_DELAY_POWER_ON_US);
+
+    // 4‑bit init sequence; stop at the first transfer that fails (panel absent
+    // or not answering)
+    esp_err_t err = _write_nibble(lcd, 0x03, false);
+    _defer(lcd, LCD_DELAY_INIT1_US);
+    if (err == ESP_OK) err = _write_nibble(lcd, 0x03, false);
+    _defer(lcd, LCD_DELAY_INIT2_US);
+    if (err == ESP_OK) err = _write_nibble(lcd, 0x03, false);
+    _defer(lcd, LCD_DELAY_INIT3_US);
+    if (err == ESP_OK) err = _write_nibble(lcd, 0x02, false);
 
     // configure display
-    lcd20x4_function_set      (lcd, false, true, false);
-    lcd20x4_display_control   (lcd, false, false, false);
-    lcd20x4_clear             (lcd);
-    lcd20x4_set_entry_mode    (lcd, true, false);
-    lcd20x4_display_control   (lcd, true, false, false);
+    if (err == ESP_OK) err = lcd20x4_function_set   (lcd, false, true, false);
+    if (err == ESP_OK) err = lcd20x4_display_control(lcd, false, false, false);
+    if (err == ESP_OK) err = lcd20x4_clear          (lcd);
+    if (err == ESP_OK) err = lcd20x4_set_entry_mode (lcd, true, false);
+    if (err == ESP_OK) err = lcd20x4_display_control(lcd, true, false, false);
 
-    return ESP_OK;
-}
+    return err;
+}// eo lcd20x4_init_io::
 
 
 /*>>> lcd20x4_clear: ==========================================================
 Author:		Vamseedhar Reddy, Samip Patel
 Date:		10/07/2025
-Modified:	None
-Desc:		This function will clear the LCD display.
+Modified:	17/10/2026
+Desc:		This function will clear the LCD display. The 2 ms execution time
+			is recorded as a deadline instead of being spun here.
 Input: 		- lcd: Pointer to the LCD driver structure
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
 esp_err_t lcd20x4_clear(lcd_20x4_driver_t *lcd) {
     esp_err_t r = _write_byte(lcd, CMD_CLEAR_DISPLAY, false);
-    esp_rom_delay_us(LCD_DELAY_CLEAR_US);
+    _defer(lcd, LCD_DELAY_CLEAR_US); // next transfer waits, not this call
+    // panel is now all blanks
+    memset(&lcd->shown, ' ', sizeof(lcd->shown));
+    memset(lcd->stale, 0, sizeof(lcd->stale));
+    lcd->shown_valid = (r == ESP_OK);
     return r;
 }// eo lcd20x4_clear::
 
 /*>>> lcd20x4_home: ==========================================================
 Author:		Vamseedhar Reddy, Samip Patel
 Date:		10/07/2025
-Modified:	None
-Desc:		This function will return the cursor to the home position.
+Modified:	17/10/2026
+Desc:		This function will return the cursor to the home position. The 2 ms
+			execution time is recorded as a deadline instead of being spun here.
 Input: 		- lcd: Pointer to the LCD driver structure
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
 esp_err_t lcd20x4_home(lcd_20x4_driver_t *lcd) {
     esp_err_t r = _write_byte(lcd, CMD_RETURN_HOME, false);
-    esp_rom_delay_us(LCD_DELAY_HOME_US);
+    _defer(lcd, LCD_DELAY_HOME_US); // next transfer waits, not this call
     return r;
 }// eo lcd20x4_home::
 
@@ -276,20 +371,34 @@ esp_err_t lcd20x4_set_ddram_addr(lcd_20x4_driver_t *lcd, uint8_t addr) {
     return _write_byte(lcd, CMD_SET_DDRAM_ADDR | (addr & 0x7F), false);
 }// eo lcd20x4_set_ddram_addr::
 
+/*>>> _row_offset: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will return the DDRAM address of a row's first cell.
+			Rows 2/3 continue lines 1/2 right after the panel width, so a 20x4
+			gives 0x00/0x40/0x14/0x54 and a 16x4 0x00/0x40/0x10/0x50.
+Input: 		- lcd: Pointer to the LCD driver structure
+			- row: The row (0-3)
+Returns:	DDRAM address.
+ ============================================================================*/
+static inline uint8_t _row_offset(const lcd_20x4_driver_t *lcd, uint8_t row) {
+    return (uint8_t)(((row & 1) ? 0x40 : 0x00) + (row >> 1) * lcd->cols);
+}// eo _row_offset::
+
 /*>>> lcd20x4_set_cursor: ==========================================================
 Author:		Vamseedhar Reddy, Samip Patel
 Date:		10/07/2025
-Modified:	None
+Modified:	17/10/2026
 Desc:		This function will set the cursor position for the LCD.
 Input: 		- lcd: Pointer to the LCD driver structure
 			- col: The column to set (0-19)
 			- row: The row to set (0-3)
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
-static const uint8_t _row_offsets[4] = { 0x00, 0x40, 0x14, 0x54 };
 esp_err_t lcd20x4_set_cursor(lcd_20x4_driver_t *lcd, uint8_t col, uint8_t row) {
     if (row >= lcd->rows) row = lcd->rows - 1;
-    return lcd20x4_set_ddram_addr(lcd, col + _row_offsets[row]);
+    return lcd20x4_set_ddram_addr(lcd, col + _row_offset(lcd, row));
 }// eo lcd20x4_set_cursor::
 
 /*>>> lcd20x4_write_char: ==========================================================
@@ -302,22 +411,31 @@ Input: 		- lcd: Pointer to the LCD driver structure
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
 esp_err_t lcd20x4_write_char(lcd_20x4_driver_t *lcd, char c) {
+    lcd->shown_valid = false; // bypasses the shadow framebuffer
     return _write_byte(lcd, (uint8_t)c, true);
 }// eo lcd20x4_write_char::
 
 /*>>> lcd20x4_write_string: ==========================================================
 Author:		Vamseedhar Reddy, Samip Patel
 Date:		10/07/2025
-Modified:	None
-Desc:		This function will write a string to the LCD.
+Modified:	17/10/2026
+Desc:		This function will write a string to the LCD, batching the
+			characters into burst transfers instead of one write per nibble.
 Input: 		- lcd: Pointer to the LCD driver structure
 			- str: The string to write
 Returns:	ESP_OK on success, or an error code on failure.
  ============================================================================*/
 esp_err_t lcd20x4_write_string(lcd_20x4_driver_t *lcd, const char *str) {
     esp_err_t err = ESP_OK;
+    lcd->shown_valid = false; // bypasses the shadow framebuffer
+    // send the string in bursts of up to a frame's worth of characters
+    err = _io_wait(lcd); // burst buffer may still be in flight
     while (*str && err == ESP_OK) {
-        err = lcd20x4_write_char(lcd, *str++);
+        size_t n = 0;
+        while (*str && n + LCD_BYTES_PER_CHAR <= sizeof(lcd->burst)) {
+            n += _encode_byte(lcd, lcd->burst + n, (uint8_t)*str++, true);
+        }
+        err = _io_write(lcd, lcd->burst, n);
     }
     return err;
 }// eo lcd20x4_write_string::
@@ -336,3 +454,569 @@ esp_err_t lcd20x4_set_backlight(lcd_20x4_driver_t *lcd, bool on) {
     // to actually update the expander, you could re-send the last nibble, etc.
     return ESP_OK;
 }// eo lcd20x4_set_backlight::
+
+
+// Shadow framebuffer
+
+/*>>> lcd20x4_frame_clear: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will blank a standalone frame.
+Input: 		- frame: Pointer to the frame
+Returns:	None
+ ============================================================================*/
+void lcd20x4_frame_clear(lcd20x4_frame_t *frame) {
+    memset(frame, ' ', sizeof(*frame));
+}// eo lcd20x4_frame_clear::
+
+/*>>> lcd20x4_frame_write: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will write a string into a standalone frame,
+			clipped at the end of the row.
+Input: 		- frame: Pointer to the frame
+			- col: The starting column (0-19)
+			- row: The row (0-3)
+			- str: The string to write
+Returns:	None
+ ============================================================================*/
+void lcd20x4_frame_write(lcd20x4_frame_t *frame, uint8_t col, uint8_t row, const char *str) {
+    if (row >= LCD_ROWS_MAX) return;
+    while (*str && col < LCD_COLS_MAX) {
+        frame->cells[row][col++] = *str++;
+    }
+}// eo lcd20x4_frame_write::
+
+/*>>> lcd20x4_fb_clear: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will blank the shadow framebuffer. Nothing is sent to
+			the panel until lcd20x4_commit() is called.
+Input: 		- lcd: Pointer to the LCD driver structure
+Returns:	None
+ ============================================================================*/
+void lcd20x4_fb_clear(lcd_20x4_driver_t *lcd) {
+    lcd20x4_frame_clear(&lcd->fb);
+}// eo lcd20x4_fb_clear::
+
+/*>>> lcd20x4_fb_write: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will write a string into the shadow framebuffer,
+			clipped at the end of the row.
+Input: 		- lcd: Pointer to the LCD driver structure
+			- col: The starting column (0-19)
+			- row: The row (0-3)
+			- str: The string to write
+Returns:	None
+ ============================================================================*/
+void lcd20x4_fb_write(lcd_20x4_driver_t *lcd, uint8_t col, uint8_t row, const char *str) {
+    lcd20x4_frame_write(&lcd->fb, col, row, str);
+}// eo lcd20x4_fb_write::
+
+/*>>> _resolve_glyphs: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will replace every LCD_GLYPH(id) placeholder in the
+			framebuffer with the CGRAM code of that glyph, uploading it first
+			on a cache miss. The slots already holding a glyph of this frame are
+			pinned beforehand, so a miss never evicts one the frame still needs.
+			Unknown IDs, and glyphs beyond LCD_CGRAM_SLOTS, are drawn as blanks.
+Input: 		- lcd: Pointer to the LCD driver structure
+Returns:	None
+ ============================================================================*/
+static void _resolve_glyphs(lcd_20x4_driver_t *lcd) {
+    // glyph IDs the frame references
+    uint16_t wanted = 0;
+    for (uint8_t row = 0; row < lcd->rows; row++) {
+        for (uint8_t col = 0; col < lcd->cols; col++) {
+            uint8_t v = (uint8_t)lcd->fb.cells[row][col];
+            if (v >= LCD_GLYPH_REF_BASE && v < LCD_GLYPH_REF_BASE + LCD_GLYPH_MAX) {
+                wanted |= 1u << (v - LCD_GLYPH_REF_BASE);
+            }
+        }
+    }
+    if (!wanted) return;
+
+    lcd->slot_pinned = 0;
+    for (uint8_t slot = 0; slot < LCD_CGRAM_SLOTS; slot++) {
+        if (lcd->slot_glyph[slot] && (wanted & (1u << (lcd->slot_glyph[slot] - 1)))) {
+            lcd->slot_pinned |= 1u << slot;
+        }
+    }
+
+    for (uint8_t row = 0; row < lcd->rows; row++) {
+        for (uint8_t col = 0; col < lcd->cols; col++) {
+            char *cell = &lcd->fb.cells[row][col];
+            uint8_t v = (uint8_t)*cell;
+            if (v < LCD_GLYPH_REF_BASE || v >= LCD_GLYPH_REF_BASE + LCD_GLYPH_MAX) continue;
+            if (lcd20x4_glyph_acquire(lcd, v - LCD_GLYPH_REF_BASE, cell) != ESP_OK) {
+                *cell = ' ';
+                continue;
+            }
+            lcd->slot_pinned |= 1u << ((uint8_t)*cell - LCD_GLYPH_CODE_BASE);
+        }
+    }
+    lcd->slot_pinned = 0;
+}// eo _resolve_glyphs::
+
+/*>>> lcd20x4_commit_step: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will compare the shadow framebuffer with what the panel
+			already shows and send the changed runs, up to `max_bytes` of
+			PCF8574 traffic (a run that does not fit is split). Each run is a
+			DDRAM address command followed by its characters; the runs are sent
+			as one transaction which, on an asynchronous bus, is only queued.
+			Cells sent are recorded in `shown`, so the next step continues with
+			whatever still differs.
+Input: 		- lcd: Pointer to the LCD driver structure
+			- max_bytes: Traffic budget for this step
+			- pending: Optional; set to true if changes are left for a later step
+Returns:	ESP_OK on success, or an error code on failure.
+ ============================================================================*/
+esp_err_t lcd20x4_commit_step(lcd_20x4_driver_t *lcd, size_t max_bytes, bool *pending) {
+    // the previous commit may still be streaming out of the burst buffer
+    esp_err_t err = _io_wait(lcd);
+    if (err != ESP_OK) {
+        lcd->shown_valid = false; // panel state unknown, redraw everything
+        if (err == ESP_ERR_TIMEOUT) return err; // burst buffer still queued, leave it alone
+    }
+    if (!lcd->shown_valid) {
+        // resend every cell, however many steps that takes
+        for (uint8_t row = 0; row < LCD_ROWS_MAX; row++) {
+            lcd->stale[row] = (1UL << LCD_COLS_MAX) - 1;
+        }
+        lcd->shown_valid = true;
+    }
+    if (max_bytes > sizeof(lcd->burst)) max_bytes = sizeof(lcd->burst);
+    if (max_bytes < 2 * LCD_BYTES_PER_CHAR) max_bytes = 2 * LCD_BYTES_PER_CHAR; // address + one cell
+    _resolve_glyphs(lcd);
+
+    size_t n = 0;
+    bool more = false;
+    for (uint8_t row = 0; row < lcd->rows && !more; row++) {
+        const char *want  = lcd->fb.cells[row];
+        char       *have  = lcd->shown.cells[row];
+        uint32_t   *stale = &lcd->stale[row];
+        uint8_t col = 0;
+        while (col < lcd->cols) {
+            // skip cells that are already correct
+            if (!(*stale & (1UL << col)) && want[col] == have[col]) {
+                col++;
+                continue;
+            }
+            // out of budget: leave the rest for the next step
+            if (n + 2 * LCD_BYTES_PER_CHAR > max_bytes) {
+                more = true;
+                break;
+            }
+            // extend the run over every differing cell that fits the budget
+            size_t  fit = (max_bytes - n - LCD_BYTES_PER_CHAR) / LCD_BYTES_PER_CHAR;
+            uint8_t end = col;
+            while (end < lcd->cols && (size_t)(end - col) < fit &&
+                   ((*stale & (1UL << end)) || want[end] != have[end])) {
+                *stale &= ~(1UL << end);
+                end++;
+            }
+            n += _encode_run(lcd, lcd->burst + n, col + _row_offset(lcd, row), &want[col], end - col);
+            memcpy(&have[col], &want[col], end - col);
+            col = end;
+        }
+    }
+    if (pending) *pending = more;
+    if (n == 0) return ESP_OK;
+
+    // all runs go out as one transaction; on an async bus this returns at once
+    err = _io_submit(lcd, lcd->burst, n);
+    if (err != ESP_OK) lcd->shown_valid = false;
+    return err;
+}// eo lcd20x4_commit_step::
+
+/*>>> lcd20x4_commit: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will send every changed run of the shadow framebuffer
+			in one transaction (a full frame always fits the burst buffer).
+Input: 		- lcd: Pointer to the LCD driver structure
+Returns:	ESP_OK on success, or an error code on failure.
+ ============================================================================*/
+esp_err_t lcd20x4_commit(lcd_20x4_driver_t *lcd) {
+    return lcd20x4_commit_step(lcd, LCD_BURST_MAX, NULL);
+}// eo lcd20x4_commit::
+
+// Formatter
+
+typedef struct {
+    lcd20x4_frame_t *frame;
+    uint8_t          row;
+    uint8_t          col;
+    int              count;
+} _fmt_out_t; // Output cursor of lcd20x4_frame_vprintf
+
+static const uint32_t _pow10[LCD_PRINTF_MAX_PREC + 1] = { 1, 10, 100, 1000, 10000 };
+
+/*>>> _fmt_put: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will store one character at the output cursor,
+			dropping it once the end of the row is reached.
+Input: 		- out: Output cursor
+			- c: The character
+Returns:	None
+ ============================================================================*/
+static void _fmt_put(_fmt_out_t *out, char c) {
+    if (out->col < LCD_COLS_MAX) {
+        out->frame->cells[out->row][out->col++] = c;
+        out->count++;
+    }
+}// eo _fmt_put::
+
+/*>>> _fmt_pad: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will emit `n` copies of a padding character.
+Input: 		- out: Output cursor
+			- c: Padding character
+			- n: Count (may be negative, meaning none)
+Returns:	None
+ ============================================================================*/
+static void _fmt_pad(_fmt_out_t *out, char c, int n) {
+    while (n-- > 0) _fmt_put(out, c);
+}// eo _fmt_pad::
+
+/*>>> _fmt_text: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will print `len` characters of a string, padded with
+			spaces to the field width.
+Input: 		- out: Output cursor
+			- str: Characters to print
+			- len: Number of characters
+			- width: Minimum field width
+			- left: Left-justify within the field
+Returns:	None
+ ============================================================================*/
+static void _fmt_text(_fmt_out_t *out, const char *str, int len, int width, bool left) {
+    if (!left) _fmt_pad(out, ' ', width - len);
+    for (int i = 0; i < len; i++) _fmt_put(out, str[i]);
+    if (left) _fmt_pad(out, ' ', width - len);
+}// eo _fmt_text::
+
+/*>>> _fmt_number: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will print a magnitude as a fixed-point decimal
+			number with `decimals` implied decimal places, honouring sign,
+			field width and the '-' / '0' flags.
+Input: 		- out: Output cursor
+			- mag: Absolute value, scaled by 10^decimals
+			- neg: True to print a minus sign
+			- decimals: Implied decimal places (0..LCD_PRINTF_MAX_PREC)
+			- width: Minimum field width
+			- left: Left-justify within the field
+			- zero: Pad with zeros instead of spaces
+Returns:	None
+ ============================================================================*/
+static void _fmt_number(_fmt_out_t *out, uint32_t mag, bool neg, uint8_t decimals,
+                        int width, bool left, bool zero) {
+    char digits[16]; // 10 digits + point, reversed
+    int  n = 0;
+    do {
+        if (decimals && n == decimals) digits[n++] = '.';
+        digits[n++] = (char)('0' + mag % 10);
+        mag /= 10;
+    } while (mag || (decimals && n <= decimals));
+
+    int pad = width - n - (neg ? 1 : 0);
+    if (!left && !zero) _fmt_pad(out, ' ', pad);
+    if (neg) _fmt_put(out, '-');
+    if (!left && zero) _fmt_pad(out, '0', pad);
+    while (n) _fmt_put(out, digits[--n]);
+    if (left) _fmt_pad(out, ' ', pad);
+}// eo _fmt_number::
+
+/*>>> lcd20x4_frame_vprintf: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will format directly into a frame's cells using a
+			small integer-only formatter (see lcd_20x4_driver.h).
+Input: 		- frame: Pointer to the frame
+			- col: The starting column (0-19)
+			- row: The row (0-3)
+			- fmt: Format string
+			- ap: Arguments
+Returns:	Number of cells written.
+ ============================================================================*/
+int lcd20x4_frame_vprintf(lcd20x4_frame_t *frame, uint8_t col, uint8_t row, const char *fmt, va_list ap) {
+    if (row >= LCD_ROWS_MAX) return 0;
+    _fmt_out_t out = { .frame = frame, .row = row, .col = col, .count = 0 };
+
+    for (; *fmt; fmt++) {
+        if (*fmt != '%') {
+            _fmt_put(&out, *fmt);
+            continue;
+        }
+        const char *spec = fmt;
+
+        // flags, width, precision, length
+        bool left = false, zero = false;
+        for (;; fmt++) {
+            if      (fmt[1] == '-') left = true;
+            else if (fmt[1] == '0') zero = true;
+            else break;
+        }
+        int width = 0;
+        while (fmt[1] >= '0' && fmt[1] <= '9') width = width * 10 + (*++fmt - '0');
+        int prec = -1;
+        if (fmt[1] == '.') {
+            fmt++;
+            prec = 0;
+            while (fmt[1] >= '0' && fmt[1] <= '9') prec = prec * 10 + (*++fmt - '0');
+        }
+        bool is_long = (fmt[1] == 'l');
+        if (is_long) fmt++;
+        uint8_t decimals = (prec < 0) ? 1 : (prec > LCD_PRINTF_MAX_PREC ? LCD_PRINTF_MAX_PREC : prec);
+
+        switch (*++fmt) {
+        case 'd':
+        case 'i': {
+            long v = is_long ? va_arg(ap, long) : va_arg(ap, int);
+            _fmt_number(&out, v < 0 ? 0UL - (unsigned long)v : (unsigned long)v, v < 0, 0, width, left, zero);
+            break;
+        }
+        case 'u': {
+            unsigned long v = is_long ? va_arg(ap, unsigned long) : va_arg(ap, unsigned int);
+            _fmt_number(&out, v, false, 0, width, left, zero);
+            break;
+        }
+        case 'k': {
+            long v = is_long ? va_arg(ap, long) : va_arg(ap, int);
+            if (prec < 0) decimals = 0;
+            _fmt_number(&out, v < 0 ? 0UL - (unsigned long)v : (unsigned long)v, v < 0, decimals, width, left, zero);
+            break;
+        }
+        case 'f': {
+            double v = va_arg(ap, double);
+            if (isnan(v)) {
+                _fmt_text(&out, "nan", 3, width, left);
+                break;
+            }
+            bool neg = v < 0;
+            if (neg) v = -v;
+            if (isinf(v)) {
+                _fmt_text(&out, neg ? "-inf" : "inf", neg ? 4 : 3, width, left);
+                break;
+            }
+            // clamp before converting: out-of-range double -> uint32_t is undefined
+            uint32_t mag = (v >= (UINT32_MAX - 0.5) / _pow10[decimals])
+                         ? UINT32_MAX : (uint32_t)(v * _pow10[decimals] + 0.5);
+            _fmt_number(&out, mag, neg && mag != 0, decimals, width, left, zero);
+            break;
+        }
+        case 's': {
+            const char *str = va_arg(ap, const char *);
+            if (!str) str = "(null)";
+            int len = 0;
+            while (str[len] && (prec < 0 || len < prec)) len++;
+            _fmt_text(&out, str, len, width, left);
+            break;
+        }
+        case 'c':
+            if (!left) _fmt_pad(&out, ' ', width - 1);
+            _fmt_put(&out, (char)va_arg(ap, int));
+            if (left) _fmt_pad(&out, ' ', width - 1);
+            break;
+        case 'D':
+            _fmt_put(&out, LCD_DEGREE_CHAR);
+            break;
+        case '%':
+            _fmt_put(&out, '%');
+            break;
+        case '\0':
+            fmt--; // dangling '%' at the end of the format
+            /* fall through */
+        default:
+            // unknown conversion: print it verbatim
+            for (const char *p = spec; p <= fmt; p++) _fmt_put(&out, *p);
+            break;
+        }
+    }
+    return out.count;
+}// eo lcd20x4_frame_vprintf::
+
+/*>>> lcd20x4_frame_printf: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will format into a standalone frame.
+Input: 		- frame: Pointer to the frame
+			- col: The starting column (0-19)
+			- row: The row (0-3)
+			- fmt: Format string, followed by its arguments
+Returns:	Number of cells written.
+ ============================================================================*/
+int lcd20x4_frame_printf(lcd20x4_frame_t *frame, uint8_t col, uint8_t row, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = lcd20x4_frame_vprintf(frame, col, row, fmt, ap);
+    va_end(ap);
+    return n;
+}// eo lcd20x4_frame_printf::
+
+/*>>> lcd20x4_printf: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will format into the driver's framebuffer; the text
+			reaches the panel with the next lcd20x4_commit().
+Input: 		- lcd: Pointer to the LCD driver structure
+			- col: The starting column (0-19)
+			- row: The row (0-3)
+			- fmt: Format string, followed by its arguments
+Returns:	Number of cells written.
+ ============================================================================*/
+int lcd20x4_printf(lcd_20x4_driver_t *lcd, uint8_t col, uint8_t row, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = lcd20x4_frame_vprintf(&lcd->fb, col, row, fmt, ap);
+    va_end(ap);
+    return n;
+}// eo lcd20x4_printf::
+
+/*>>> lcd20x4_set_glyph_table: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will register the glyphs that can be requested by ID
+			and empty the cache so they are uploaded again on first use.
+Input: 		- lcd: Pointer to the LCD driver structure
+			- table: Glyph bitmaps indexed by ID (must stay valid)
+			- count: Number of entries (at most LCD_GLYPH_MAX)
+Returns:	None
+ ============================================================================*/
+void lcd20x4_set_glyph_table(lcd_20x4_driver_t *lcd, const lcd20x4_glyph_t *table, uint8_t count) {
+    lcd->glyphs      = table;
+    lcd->glyph_count = (count > LCD_GLYPH_MAX) ? LCD_GLYPH_MAX : count;
+    memset(lcd->slot_glyph, 0, sizeof(lcd->slot_glyph));
+    memset(lcd->slot_used, 0, sizeof(lcd->slot_used));
+    lcd->slot_pinned = 0;
+}// eo lcd20x4_set_glyph_table::
+
+/*>>> lcd20x4_glyph_acquire: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will return the character code of a glyph, uploading
+			it to a free or the least recently used unpinned CGRAM slot on a miss.
+Input: 		- lcd: Pointer to the LCD driver structure
+			- id: Index of the glyph in the registered table
+			- code: Where to store the character code to draw
+Returns:	ESP_OK on success, ESP_ERR_NOT_FOUND for an unknown ID,
+			ESP_ERR_NO_MEM if every slot is pinned, or an I²C error code if
+			the upload failed.
+ ============================================================================*/
+esp_err_t lcd20x4_glyph_acquire(lcd_20x4_driver_t *lcd, uint8_t id, char *code) {
+    if (!lcd->glyphs || id >= lcd->glyph_count) return ESP_ERR_NOT_FOUND;
+
+    // hit: just refresh the LRU stamp
+    uint8_t victim = LCD_CGRAM_SLOTS;
+    for (uint8_t slot = 0; slot < LCD_CGRAM_SLOTS; slot++) {
+        if (lcd->slot_glyph[slot] == id + 1) {
+            lcd->slot_used[slot] = ++lcd->glyph_clock;
+            *code = (char)(LCD_GLYPH_CODE_BASE + slot);
+            return ESP_OK;
+        }
+        // free slots have stamp 0, so they are picked before any used one
+        if (lcd->slot_pinned & (1u << slot)) continue;
+        if (victim == LCD_CGRAM_SLOTS || lcd->slot_used[slot] < lcd->slot_used[victim]) victim = slot;
+    }
+    if (victim == LCD_CGRAM_SLOTS) return ESP_ERR_NO_MEM;
+
+    // miss: CGRAM address + 8 pixel rows in one burst
+    uint8_t buf[(1 + LCD_GLYPH_ROWS) * LCD_BYTES_PER_CHAR];
+    size_t n = _encode_byte(lcd, buf, CMD_SET_CGRAM_ADDR | (victim * LCD_GLYPH_ROWS), false);
+    for (uint8_t i = 0; i < LCD_GLYPH_ROWS; i++) {
+        n += _encode_byte(lcd, buf + n, lcd->glyphs[id].rows[i] & 0x1F, true);
+    }
+    esp_err_t err = _io_write(lcd, buf, n);
+    if (err != ESP_OK) {
+        lcd->slot_glyph[victim] = 0;
+        lcd->slot_used[victim]  = 0;
+        return err;
+    }
+    lcd->slot_glyph[victim] = id + 1;
+    lcd->slot_used[victim]  = ++lcd->glyph_clock;
+    *code = (char)(LCD_GLYPH_CODE_BASE + victim);
+    return ESP_OK;
+}// eo lcd20x4_glyph_acquire::
+
+/*>>> lcd20x4_frame_glyph: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will place a glyph reference in a frame; it is
+			resolved to a CGRAM code by the driver when the frame is committed.
+Input: 		- frame: Pointer to the frame
+			- col: The column (0-19)
+			- row: The row (0-3)
+			- id: Index of the glyph in the registered table
+Returns:	None
+ ============================================================================*/
+void lcd20x4_frame_glyph(lcd20x4_frame_t *frame, uint8_t col, uint8_t row, uint8_t id) {
+    if (row >= LCD_ROWS_MAX || col >= LCD_COLS_MAX || id >= LCD_GLYPH_MAX) return;
+    frame->cells[row][col] = LCD_GLYPH(id);
+}// eo lcd20x4_frame_glyph::
+
+/*>>> lcd20x4_invalidate: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will forget what the panel shows so that the next
+			commit redraws every cell (e.g. after a glitch on the bus).
+Input: 		- lcd: Pointer to the LCD driver structure
+Returns:	None
+ ============================================================================*/
+void lcd20x4_invalidate(lcd_20x4_driver_t *lcd) {
+    lcd->shown_valid = false;
+}// eo lcd20x4_invalidate::
+
+/*>>> lcd20x4_get_stats: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will copy out the bus traffic counters. Bytes and
+			transactions are counted here; bus time comes from the transport.
+Input: 		- lcd: Pointer to the LCD driver structure
+			- out: Where to store the counters
+Returns:	None
+ ============================================================================*/
+void lcd20x4_get_stats(const lcd_20x4_driver_t *lcd, lcd20x4_stats_t *out) {
+    *out = lcd->stats;
+    out->bus_time_us = lcd->io->bus_time_us;
+}// eo lcd20x4_get_stats::
+
+/*>>> lcd20x4_reset_stats: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will zero the bus traffic counters.
+Input: 		- lcd: Pointer to the LCD driver structure
+Returns:	None
+ ============================================================================*/
+void lcd20x4_reset_stats(lcd_20x4_driver_t *lcd) {
+    memset(&lcd->stats, 0, sizeof(lcd->stats));
+    lcd->io->bus_time_us = 0;
+}// eo lcd20x4_reset_stats::
@@ -2,7 +2,7 @@
 File Name:	lcd_20x4_driver.h
 Author:		Vamseedhar Reddy, Samip Patel
 Date:		10/07/2025
-Modified:	None
+Modified:	17/10/2026
 © Fanshawe College, 2025
 
 Description: This file contains the interface for the LCD 20x4 driver,
@@ -18,8 +18,11 @@ including function declarations for initializing and controlling the display.
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_err.h"
-#include "driver/i2c.h"
-#include "driver/gpio.h"
+#include "sdkconfig.h"
+#include "lcd_20x4_transport.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include "lcd_20x4_i2c.h"
+#endif
 
 // HD44780 commands
 #define CMD_CLEAR_DISPLAY       0x01 // Clear display
@@ -75,35 +78,107 @@ including function declarations for initializing and controlling the display.
 #define LCD_DELAY_ENABLE_PULSE_US   1 // Enable pulse delay count
 #define LCD_DELAY_ENABLE_SETTLE_US  50 // Enable settle delay count
 
+// Shadow framebuffer geometry (largest panel supported)
+#define LCD_ROWS_MAX    4  // Maximum number of rows
+#define LCD_COLS_MAX    20 // Maximum number of columns
+
+// Burst encoding: each nibble is clocked by three expander writes (data, data|EN, data)
+#define LCD_BYTES_PER_NIBBLE    3                                  // PCF8574 bytes per nibble
+#define LCD_BYTES_PER_CHAR      (2 * LCD_BYTES_PER_NIBBLE)         // PCF8574 bytes per LCD byte
+#define LCD_BURST_MAX           (LCD_ROWS_MAX * (LCD_COLS_MAX + 1) * LCD_BYTES_PER_CHAR) // every row: address + cells
+
+// CGRAM glyph cache: 8 custom characters, addressed as codes 0x08..0x0F
+// (the HD44780 mirrors CGRAM 0..7 there, which keeps them clear of '\0').
+// Frames reference a glyph by ID with the placeholder LCD_GLYPH(id); the
+// driver uploads it on a miss and substitutes the slot code at commit time.
+#define LCD_CGRAM_SLOTS         8     // Custom character slots
+#define LCD_GLYPH_ROWS          8     // Pixel rows per 5x8 glyph
+#define LCD_GLYPH_CODE_BASE     0x08  // Character code of slot 0
+#define LCD_GLYPH_REF_BASE      0x10  // Placeholder for glyph ID 0 (ROM codes 0x10..0x1F are blank)
+#define LCD_GLYPH_MAX           16    // Glyph IDs that fit the placeholder range
+#define LCD_GLYPH(id)           ((char)(LCD_GLYPH_REF_BASE + (id)))
+
+// lcd20x4_printf
+#define LCD_DEGREE_CHAR         ((char)0xDF) // ROM degree sign, printed by %D
+#define LCD_PRINTF_MAX_PREC     4            // Largest decimal precision for %f / %k
+
+typedef struct {
+    char cells[LCD_ROWS_MAX][LCD_COLS_MAX];
+} lcd20x4_frame_t; // One screenful of characters
+
+typedef struct {
+    uint8_t rows[LCD_GLYPH_ROWS]; // 5-bit pixel rows, top to bottom
+} lcd20x4_glyph_t; // One custom 5x8 character
+
+typedef struct {
+    uint32_t bytes;        // bytes written to the PCF8574
+    uint32_t transactions; // I2C write transactions issued
+    uint32_t bus_time_us;  // time those transactions spent on the wire (as reported by the transport)
+} lcd20x4_stats_t; // Bus traffic counters
+
 typedef struct {
-    i2c_port_t    port;
-    uint8_t       address;
-    bool          backlight;
-    uint8_t       rows;
-    uint8_t       cols;
+    lcd20x4_transport_t *io;     // where the PCF8574 bytes go
+#if !CONFIG_IDF_TARGET_LINUX
+    lcd20x4_i2c_t   i2c;         // transport used by lcd20x4_init()
+#endif
+    uint8_t         address;
+    bool            backlight;
+    uint8_t         rows;
+    uint8_t         cols;
+    lcd20x4_frame_t fb;          // frame being composed by the application
+    lcd20x4_frame_t shown;       // what the panel currently displays
+    bool            shown_valid; // false after direct writes bypassed the shadow
+    uint32_t        stale[LCD_ROWS_MAX]; // per row: cells to resend even if `shown` matches
+    lcd20x4_stats_t stats;       // traffic since init / last reset
+    uint8_t         burst[LCD_BURST_MAX]; // PCF8574 byte stream being assembled
+    int64_t           ready_at_us; // HD44780 busy until this transport time
+    // CGRAM glyph cache
+    const lcd20x4_glyph_t *glyphs;                  // table indexed by glyph ID
+    uint8_t           glyph_count;                  // entries in `glyphs`
+    uint8_t           slot_glyph[LCD_CGRAM_SLOTS];  // glyph ID + 1 held by each slot (0 = free)
+    uint32_t          slot_used[LCD_CGRAM_SLOTS];   // LRU stamp of each slot
+    uint32_t          glyph_clock;                  // LRU stamp source
+    uint8_t           slot_pinned;                  // slots the frame being committed still needs
 } lcd_20x4_driver_t; // LCD 20x4 driver structure
 
 /**
- * @brief Initialize both the I²C bus and the LCD itself.
+ * @brief Initialise the LCD behind any transport (e.g. the host emulator in
+ *        lcd_20x4_emu.h). The transport must outlive the driver.
  * @param lcd         Pointer to driver state.
- * @param i2c_port    I2C_NUM_0 or _1
- * @param sda_gpio    GPIO_NUM_x for SDA
- * @param scl_gpio    GPIO_NUM_x for SCL
- * @param clk_speed   Bus speed in Hz (e.g. 100000)
+ * @param io          Transport to write through
+ * @param backlight   true=on, false=off
+ * @param rows        e.g. 4
+ * @param cols        e.g. 20
+ * @return ESP_OK, or the first transport error of the init sequence (e.g.
+ *         no panel answering at the address).
+ */
+esp_err_t lcd20x4_init_io(lcd_20x4_driver_t *lcd,
+                          lcd20x4_transport_t *io,
+                          bool backlight,
+                          uint8_t rows,
+                          uint8_t cols);
+
+#if !CONFIG_IDF_TARGET_LINUX
+/**
+ * @brief Attach the LCD to an already created I²C master bus and initialise it.
+ *        If the bus was created with trans_queue_depth > 0, framebuffer commits
+ *        are queued asynchronously and return before the bytes are on the wire.
+ * @param lcd         Pointer to driver state.
+ * @param bus         Shared bus from i2c_new_master_bus()
+ * @param clk_speed   SCL speed in Hz for this device (e.g. 100000)
  * @param lcd_addr    7‑bit PCF8574 address (e.g. 0x27)
  * @param backlight   true=on, false=off
  * @param rows        e.g. 4
  * @param cols        e.g. 20
  */
 esp_err_t lcd20x4_init(lcd_20x4_driver_t *lcd,
-                       i2c_port_t i2c_port,
-                       gpio_num_t sda_gpio,
-                       gpio_num_t scl_gpio,
+                       i2c_master_bus_handle_t bus,
                        uint32_t clk_speed,
                        uint8_t lcd_addr,
                        bool backlight,
                        uint8_t rows,
                        uint8_t cols);
+#endif
 
 esp_err_t lcd20x4_clear(lcd_20x4_driver_t *lcd);
 esp_err_t lcd20x4_home(lcd_20x4_driver_t *lcd);
@@ -122,4 +197,61 @@ esp_err_t lcd20x4_write_string(lcd_20x4_driver_t *lcd, const char *str);
 
 esp_err_t lcd20x4_set_backlight(lcd_20x4_driver_t *lcd, bool on);
 
+/**
+ * @brief Shadow framebuffer.
+ * lcd20x4_frame_*() compose into a standalone frame (e.g. one that is handed
+ * to the render task); lcd20x4_fb_*() compose into the driver's own frame.
+ * Compose a screen with lcd20x4_fb_clear()/lcd20x4_fb_write(), then call
+ * lcd20x4_commit() to send only the cells that differ from what the panel
+ * already shows (one DDRAM address per changed run). The direct write
+ * functions above bypass the shadow and mark it stale, forcing the next
+ * commit to redraw everything. LCD_GLYPH(id) cells are resolved through the
+ * glyph cache below when committed.
+ * lcd20x4_commit_step() sends at most `max_bytes` of the changes and reports
+ * whether any are left, so several panels on one bus can take turns (see
+ * lcd_render.h).
+ */
+void      lcd20x4_frame_clear(lcd20x4_frame_t *frame);
+void      lcd20x4_frame_write(lcd20x4_frame_t *frame, uint8_t col, uint8_t row, const char *str);
+void      lcd20x4_fb_clear(lcd_20x4_driver_t *lcd);
+void      lcd20x4_fb_write(lcd_20x4_driver_t *lcd, uint8_t col, uint8_t row, const char *str);
+esp_err_t lcd20x4_commit(lcd_20x4_driver_t *lcd);
+esp_err_t lcd20x4_commit_step(lcd_20x4_driver_t *lcd, size_t max_bytes, bool *pending);
+void      lcd20x4_invalidate(lcd_20x4_driver_t *lcd);
+
+/**
+ * @brief Heap-free formatted write straight into a framebuffer.
+ * Output starts at (col,row) and is clipped at the end of the row. Supports
+ * the flags '-' and '0', a field width and:
+ *   %d %i %u %ld %lu  integers
+ *   %.Nf              double rounded to N decimals (0..4, default 1) in
+ *                     fixed point, without newlib's float formatter;
+ *                     NaN and infinities print as nan / inf / -inf
+ *   %.Nk              int fixed-point value with N implied decimals
+ *                     (e.g. 2153 with %.2k prints 21.53)
+ *   %s %c %%          string, character, percent sign
+ *   %D                degree sign
+ * Uses a bounded amount of stack and no heap.
+ * @return Number of cells written.
+ */
+int       lcd20x4_frame_vprintf(lcd20x4_frame_t *frame, uint8_t col, uint8_t row, const char *fmt, va_list ap);
+int       lcd20x4_frame_printf(lcd20x4_frame_t *frame, uint8_t col, uint8_t row, const char *fmt, ...);
+int       lcd20x4_printf(lcd_20x4_driver_t *lcd, uint8_t col, uint8_t row, const char *fmt, ...);
+
+/**
+ * @brief CGRAM glyph cache.
+ * Register a table of glyphs once; afterwards a glyph is requested by its
+ * index in that table. On a miss it is uploaded to a free or the least
+ * recently used CGRAM slot; on a hit nothing is sent. Evicting a slot
+ * changes every cell still showing it, so a single frame may use at most
+ * LCD_CGRAM_SLOTS distinct glyphs. After an upload the LCD address counter
+ * points into CGRAM: set the cursor before using the direct write functions.
+ */
+void      lcd20x4_set_glyph_table(lcd_20x4_driver_t *lcd, const lcd20x4_glyph_t *table, uint8_t count);
+esp_err_t lcd20x4_glyph_acquire(lcd_20x4_driver_t *lcd, uint8_t id, char *code);
+void      lcd20x4_frame_glyph(lcd20x4_frame_t *frame, uint8_t col, uint8_t row, uint8_t id);
+
+void      lcd20x4_get_stats(const lcd_20x4_driver_t *lcd, lcd20x4_stats_t *out);
+void      lcd20x4_reset_stats(lcd_20x4_driver_t *lcd);
+
 #endif // LCD_20X4_DRIVER_H
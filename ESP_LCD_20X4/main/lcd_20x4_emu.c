@@ -0,0 +1,300 @@
+/*=================================================================================================
+File Name:	lcd_20x4_emu.c
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the implementation of the host-side emulator transport of the
+LCD 20x4 driver. Every byte is timestamped as if it were clocked over I²C at the configured SCL
+rate; a falling edge on EN latches a nibble into the modeled HD44780, which executes complete
+instructions against its DDRAM/CGRAM and stays busy for the datasheet execution time.
+=================================================================================================*/
+
+// lcd_20x4_emu.c
+
+#include "lcd_20x4_emu.h"
+#include <string.h>
+#include "lcd_20x4_driver.h"
+
+/*>>> _emu_step_ac: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will move the address counter one cell, wrapping the
+			way the HD44780 does (2-line DDRAM: 0x00-0x27 and 0x40-0x67).
+Input: 		- emu: Pointer to the emulator
+			- up: true to increment, false to decrement
+Returns:	None
+ ============================================================================*/
+static void _emu_step_ac(lcd20x4_emu_t *emu, bool up) {
+    if (emu->cgram) {
+        emu->ac = (uint8_t)((emu->ac + (up ? 1 : -1)) & (LCD_EMU_CGRAM_SIZE - 1));
+    } else if (emu->two_line) {
+        if (up) {
+            emu->ac = (emu->ac == 0x27) ? 0x40 : (emu->ac == 0x67) ? 0x00 : emu->ac + 1;
+        } else {
+            emu->ac = (emu->ac == 0x40) ? 0x27 : (emu->ac == 0x00) ? 0x67 : emu->ac - 1;
+        }
+    } else {
+        if (up) {
+            emu->ac = (emu->ac >= 0x4F) ? 0x00 : emu->ac + 1;
+        } else {
+            emu->ac = (emu->ac == 0x00) ? 0x4F : emu->ac - 1;
+        }
+    }
+}// eo _emu_step_ac::
+
+/*>>> _emu_shift_display: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will shift the visible window over DDRAM one cell.
+Input: 		- emu: Pointer to the emulator
+			- left: true to move the text left
+Returns:	None
+ ============================================================================*/
+static void _emu_shift_display(lcd20x4_emu_t *emu, bool left) {
+    emu->disp_offset = (uint8_t)((emu->disp_offset + (left ? 1 : LCD_EMU_LINE_LEN - 1)) % LCD_EMU_LINE_LEN);
+}// eo _emu_shift_display::
+
+/*>>> _emu_execute: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will execute one complete instruction or data write
+			and mark the controller busy for its execution time.
+Input: 		- emu: Pointer to the emulator
+			- rs: true for a data write, false for an instruction
+			- val: Instruction or data byte
+			- t_us: Time the final nibble was latched
+Returns:	None
+ ============================================================================*/
+static void _emu_execute(lcd20x4_emu_t *emu, bool rs, uint8_t val, int64_t t_us) {
+    uint32_t exec = LCD_EMU_EXEC_US;
+    emu->instructions++;
+
+    if (rs) {
+        if (emu->cgram) {
+            emu->cgram_data[emu->ac] = val;
+        } else {
+            emu->ddram[emu->ac & (LCD_EMU_DDRAM_SIZE - 1)] = val;
+            if (emu->shift) _emu_shift_display(emu, emu->inc);
+        }
+        _emu_step_ac(emu, emu->inc);
+        exec = LCD_EMU_EXEC_DATA_US;
+    } else if (val & CMD_SET_DDRAM_ADDR) {
+        emu->cgram = false;
+        emu->ac    = val & 0x7F;
+    } else if (val & CMD_SET_CGRAM_ADDR) {
+        emu->cgram = true;
+        emu->ac    = val & 0x3F;
+        emu->cgram_sets++;
+    } else if (val & CMD_FUNCTION_SET) {
+        emu->eight_bit = (val & FUNC_8BIT)  != 0;
+        emu->two_line  = (val & FUNC_2LINE) != 0;
+        emu->font_5x10 = (val & FUNC_5x10)  != 0;
+        emu->have_high = false;
+    } else if (val & CMD_SHIFT) {
+        bool right = (val & 0x04) != 0; // datasheet R/L: 1 = right
+        if (val & SHIFT_DISP) {
+            _emu_shift_display(emu, !right);
+        } else {
+            _emu_step_ac(emu, right);
+        }
+    } else if (val & CMD_DISPLAY_CONTROL) {
+        emu->display_on = (val & DISP_ON)   != 0;
+        emu->cursor_on  = (val & CURSOR_ON) != 0;
+        emu->blink_on   = (val & BLINK_ON)  != 0;
+    } else if (val & CMD_ENTRY_MODE_SET) {
+        emu->inc   = (val & ENTRY_INC)      != 0;
+        emu->shift = (val & ENTRY_SHIFT_ON) != 0;
+    } else if (val & CMD_RETURN_HOME) {
+        emu->cgram = false;
+        emu->ac = 0;
+        emu->disp_offset = 0;
+        exec = LCD_EMU_EXEC_HOME_US;
+    } else if (val & CMD_CLEAR_DISPLAY) {
+        memset(emu->ddram, ' ', sizeof(emu->ddram));
+        emu->cgram = false;
+        emu->ac = 0;
+        emu->disp_offset = 0;
+        emu->inc = true;
+        exec = LCD_EMU_EXEC_HOME_US;
+    }
+    emu->busy_until_us = t_us + exec;
+}// eo _emu_execute::
+
+/*>>> _emu_port_write: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will apply one PCF8574 output byte. A high-to-low
+			transition of EN latches D7-D4 into the controller: in 8-bit mode
+			that is a whole instruction (D3-D0 read as 0), in 4-bit mode the
+			high and low halves of one arrive on successive strobes.
+Input: 		- emu: Pointer to the emulator
+			- b: Expander output byte
+			- t_us: Time the byte was acknowledged
+Returns:	None
+ ============================================================================*/
+static void _emu_port_write(lcd20x4_emu_t *emu, uint8_t b, int64_t t_us) {
+    uint8_t prev = emu->port;
+    emu->port = b;
+    if (!(prev & EN_BIT) || (b & EN_BIT)) return; // not a falling edge
+    if (prev & RW_BIT) return;                    // read cycle: nothing latched
+
+    bool    rs     = (prev & RS_BIT) != 0;
+    uint8_t nibble = prev >> 4;
+    if (t_us < emu->busy_until_us) {
+        emu->busy_violations++;
+    }
+    if (emu->eight_bit) {
+        _emu_execute(emu, rs, (uint8_t)(nibble << 4), t_us);
+    } else if (!emu->have_high) {
+        emu->high      = nibble;
+        emu->have_high = true;
+    } else {
+        emu->have_high = false;
+        _emu_execute(emu, rs, (uint8_t)((emu->high << 4) | nibble), t_us);
+    }
+}// eo _emu_port_write::
+
+/*>>> _emu_transmit: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will clock a transaction into the emulator. Each byte
+			(and the address byte before them) takes 9 bit times at the modeled
+			SCL rate; the virtual clock advances to the stop condition. If the
+			expander is absent the address byte is not acknowledged.
+Input: 		- base: Pointer to the emulator
+			- data: The bytes to write
+			- len: Number of bytes
+Returns:	ESP_OK, or ESP_FAIL if the expander is absent.
+ ============================================================================*/
+static esp_err_t _emu_transmit(lcd20x4_transport_t *base, const uint8_t *data, size_t len) {
+    lcd20x4_emu_t *emu = (lcd20x4_emu_t *)base;
+    if (emu->absent) {
+        uint32_t wire_us = (uint32_t)((LCD_EMU_I2C_BIT_OVERHEAD + 9) * 1000000ULL / emu->clk_hz);
+        emu->now_us += wire_us; // address byte only
+        emu->base.bus_time_us += wire_us;
+        emu->transactions++;
+        return ESP_FAIL;
+    }
+    int64_t start = emu->now_us;
+    for (size_t i = 0; i < len; i++) {
+        // start bit + address byte + bytes up to and including this one
+        uint64_t bits = 1 + 9 * (uint64_t)(i + 2);
+        _emu_port_write(emu, data[i], start + (int64_t)(bits * 1000000ULL / emu->clk_hz));
+    }
+    uint64_t bits = LCD_EMU_I2C_BIT_OVERHEAD + 9 * (uint64_t)(len + 1);
+    uint32_t wire_us = (uint32_t)(bits * 1000000ULL / emu->clk_hz);
+    emu->now_us += wire_us;
+    emu->base.bus_time_us += wire_us;
+    emu->bytes += len;
+    emu->transactions++;
+    return ESP_OK;
+}// eo _emu_transmit::
+
+/*>>> _emu_wait: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function returns at once: emulated transfers are synchronous.
+Input: 		- base: Pointer to the emulator (unused)
+Returns:	ESP_OK.
+ ============================================================================*/
+static esp_err_t _emu_wait(lcd20x4_transport_t *base) {
+    return ESP_OK;
+}// eo _emu_wait::
+
+/*>>> _emu_now_us: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will return the virtual clock.
+Input: 		- base: Pointer to the emulator
+Returns:	Virtual time in µs.
+ ============================================================================*/
+static int64_t _emu_now_us(lcd20x4_transport_t *base) {
+    return ((lcd20x4_emu_t *)base)->now_us;
+}// eo _emu_now_us::
+
+/*>>> _emu_sleep_until: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will advance the virtual clock to the deadline, so
+			driver waits cost no host time but still show up in now_us.
+Input: 		- base: Pointer to the emulator
+			- deadline_us: Virtual time to advance to
+Returns:	None
+ ============================================================================*/
+static void _emu_sleep_until(lcd20x4_transport_t *base, int64_t deadline_us) {
+    lcd20x4_emu_t *emu = (lcd20x4_emu_t *)base;
+    if (deadline_us > emu->now_us) emu->now_us = deadline_us;
+}// eo _emu_sleep_until::
+
+/*>>> lcd20x4_emu_init: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will put the emulator in its power-on state: 8-bit
+			interface, 1 line, display off, increment, DDRAM filled with blanks.
+Input: 		- emu: Pointer to the emulator
+			- clk_hz: Modeled SCL frequency
+Returns:	None
+ ============================================================================*/
+void lcd20x4_emu_init(lcd20x4_emu_t *emu, uint32_t clk_hz) {
+    memset(emu, 0, sizeof(*emu));
+    emu->base.transmit    = _emu_transmit;
+    emu->base.wait        = _emu_wait;
+    emu->base.now_us      = _emu_now_us;
+    emu->base.sleep_until = _emu_sleep_until;
+    emu->clk_hz           = clk_hz ? clk_hz : 100000;
+    emu->eight_bit        = true;
+    emu->inc              = true;
+    memset(emu->ddram, ' ', sizeof(emu->ddram));
+}// eo lcd20x4_emu_init::
+
+/*>>> lcd20x4_emu_row: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will read the visible characters of one row. Rows 0/1
+			are the first half of DDRAM lines 1/2 and rows 2/3 the second half,
+			as on a 20x4 panel, seen through the current display shift.
+Input: 		- emu: Pointer to the emulator
+			- row: Row to read (0-3)
+			- cols: Panel width
+			- out: cols + 1 bytes for the NUL-terminated row
+Returns:	None
+ ============================================================================*/
+void lcd20x4_emu_row(const lcd20x4_emu_t *emu, uint8_t row, uint8_t cols, char *out) {
+    uint8_t line_base = (row & 1) ? 0x40 : 0x00;
+    uint8_t first     = (row >> 1) * cols;
+    for (uint8_t col = 0; col < cols; col++) {
+        uint8_t pos = (uint8_t)((first + col + emu->disp_offset) % LCD_EMU_LINE_LEN);
+        out[col] = (char)emu->ddram[line_base + pos];
+    }
+    out[cols] = '\0';
+}// eo lcd20x4_emu_row::
+
+/*>>> lcd20x4_emu_reset_counters: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will zero the traffic counters, leaving the modeled
+			controller state untouched.
+Input: 		- emu: Pointer to the emulator
+Returns:	None
+ ============================================================================*/
+void lcd20x4_emu_reset_counters(lcd20x4_emu_t *emu) {
+    emu->bytes            = 0;
+    emu->transactions     = 0;
+    emu->instructions     = 0;
+    emu->cgram_sets       = 0;
+    emu->busy_violations  = 0;
+    emu->base.bus_time_us = 0;
+}// eo lcd20x4_emu_reset_counters::
@@ -0,0 +1,79 @@
+/*======================================================================================================
+File Name:	lcd_20x4_emu.h
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the interface for the host-side emulator transport of the LCD 20x4
+driver. It models the PCF8574 expander and the HD44780 controller behind it (4/8-bit nibble
+sequencing, DDRAM, CGRAM, entry mode, display shift and execution times) on a virtual clock, and
+counts the bytes, transactions and wire time the same traffic would cost on a real I²C bus.
+No hardware or ESP-IDF peripheral driver is needed, so it also builds for the linux target.
+====================================================================================================*/
+
+// lcd_20x4_emu.h
+#ifndef LCD_20X4_EMU_H
+#define LCD_20X4_EMU_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lcd_20x4_transport.h"
+
+#define LCD_EMU_DDRAM_SIZE      0x80  // DDRAM address space (7-bit)
+#define LCD_EMU_CGRAM_SIZE      0x40  // 8 glyphs x 8 rows
+#define LCD_EMU_LINE_LEN        40    // DDRAM cells per line in 2-line mode
+#define LCD_EMU_EXEC_US         37    // Execution time of most instructions
+#define LCD_EMU_EXEC_DATA_US    41    // Execution time of a data write
+#define LCD_EMU_EXEC_HOME_US    1520  // Execution time of clear / return home
+#define LCD_EMU_I2C_BIT_OVERHEAD 2    // Start + stop, in bit times
+
+typedef struct {
+    lcd20x4_transport_t base;      // must be first
+    uint32_t clk_hz;               // modeled SCL frequency
+    int64_t  now_us;               // virtual clock
+    // PCF8574
+    uint8_t  port;                 // last byte written to the expander
+    bool     absent;               // no expander at the address: every transaction NACKs
+    // HD44780
+    bool     eight_bit;            // interface width (power-on: 8-bit)
+    bool     have_high;            // 4-bit mode: high nibble latched, waiting for low
+    uint8_t  high;                 // latched high nibble
+    bool     two_line;             // function set N
+    bool     font_5x10;            // function set F
+    bool     display_on;           // display control D
+    bool     cursor_on;            // display control C
+    bool     blink_on;             // display control B
+    bool     inc;                  // entry mode I/D
+    bool     shift;                // entry mode S
+    bool     cgram;                // address counter points into CGRAM
+    uint8_t  ac;                   // address counter
+    uint8_t  disp_offset;          // display shift, in cells
+    int64_t  busy_until_us;        // controller busy flag
+    uint8_t  ddram[LCD_EMU_DDRAM_SIZE];
+    uint8_t  cgram_data[LCD_EMU_CGRAM_SIZE];
+    // counters (what actually arrived at the expander)
+    uint32_t bytes;                // bytes written to the PCF8574
+    uint32_t transactions;         // I²C write transactions
+    uint32_t instructions;         // complete instructions / data writes executed
+    uint32_t cgram_sets;           // Set CGRAM address instructions (one per glyph upload)
+    uint32_t busy_violations;      // strobes received while the controller was busy
+} lcd20x4_emu_t; // Emulated PCF8574 + HD44780
+
+/**
+ * @brief Power-on reset the emulator and set it up as a transport.
+ * @param emu     Emulator state
+ * @param clk_hz  I²C clock used to model wire time (e.g. 100000)
+ */
+void lcd20x4_emu_init(lcd20x4_emu_t *emu, uint32_t clk_hz);
+
+/**
+ * @brief Read back what a panel of the given geometry shows on one row.
+ * @param out  cols + 1 bytes; receives the raw character codes, NUL-terminated
+ */
+void lcd20x4_emu_row(const lcd20x4_emu_t *emu, uint8_t row, uint8_t cols, char *out);
+
+/// Zero the traffic counters (bytes, transactions, instructions, CGRAM sets, violations, bus time).
+void lcd20x4_emu_reset_counters(lcd20x4_emu_t *emu);
+
+#endif // LCD_20X4_EMU_H
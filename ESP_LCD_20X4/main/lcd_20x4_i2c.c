@@ -0,0 +1,190 @@
+/*=================================================================================================
+File Name:	lcd_20x4_i2c.c
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the I²C transport of the LCD 20x4 driver: queued PCF8574 writes
+on the i2c_master bus with a completion callback, and HD44780 deadlines kept with esp_timer.
+=================================================================================================*/
+
+// lcd_20x4_i2c.c
+
+#include "lcd_20x4_i2c.h"
+#include "lcd_20x4_driver.h"
+#include "freertos/task.h"
+#include "esp_attr.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+
+/*>>> _on_trans_done: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This ISR callback runs when a queued transfer finishes. It records
+			the bus time and result and wakes whoever waits for the buffer.
+Input: 		- dev: Device handle (unused)
+			- evt: Completion event
+			- arg: Pointer to the I²C transport
+Returns:	true if a higher-priority task was woken.
+ ============================================================================*/
+static bool IRAM_ATTR _on_trans_done(i2c_master_dev_handle_t dev, const i2c_master_event_data_t *evt, void *arg) {
+    lcd20x4_i2c_t *io = arg;
+    BaseType_t woken = pdFALSE;
+    io->base.bus_time_us += (uint32_t)(esp_timer_get_time() - io->tx_start_us);
+    io->tx_err = (evt->event == I2C_EVENT_DONE) ? ESP_OK : ESP_FAIL;
+    xSemaphoreGiveFromISR(io->tx_done, &woken);
+    return woken == pdTRUE;
+}// eo _on_trans_done::
+
+/*>>> _i2c_wait: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will block until the in-flight transfer (if any) has
+			left the bus, so its buffer may be reused. If the completion is late
+			the bus queue is drained as well; the transfer only counts as done
+			once its completion has been taken, so a late completion can never
+			be mistaken for the next transfer's.
+Input: 		- base: Pointer to the I²C transport
+Returns:	Result of the in-flight transfer, ESP_OK if there was none, or
+			ESP_ERR_TIMEOUT if it is still queued (the buffer stays in use).
+ ============================================================================*/
+static esp_err_t _i2c_wait(lcd20x4_transport_t *base) {
+    lcd20x4_i2c_t *io = (lcd20x4_i2c_t *)base;
+    if (!io->tx_busy) return ESP_OK;
+    if (xSemaphoreTake(io->tx_done, pdMS_TO_TICKS(LCD_I2C_TIMEOUT_MS)) != pdTRUE) {
+        // the callback runs before the bus reports idle, so once the queue is
+        // empty the completion has been given
+        i2c_master_bus_wait_all_done(io->bus, LCD_I2C_TIMEOUT_MS);
+        if (xSemaphoreTake(io->tx_done, 0) != pdTRUE) {
+            return ESP_ERR_TIMEOUT;
+        }
+    }
+    io->tx_busy = false;
+    return io->tx_err;
+}// eo _i2c_wait::
+
+/*>>> _i2c_transmit: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will hand a burst of bytes to the bus as a single I²C
+			transaction (one start, one address byte, one stop). On an
+			asynchronous bus it returns as soon as the transfer is queued.
+Input: 		- base: Pointer to the I²C transport
+			- data: The bytes to write
+			- len: Number of bytes
+Returns:	ESP_OK on success, or an error code on failure.
+ ============================================================================*/
+static esp_err_t _i2c_transmit(lcd20x4_transport_t *base, const uint8_t *data, size_t len) {
+    lcd20x4_i2c_t *io = (lcd20x4_i2c_t *)base;
+    if (io->tx_busy) return ESP_ERR_INVALID_STATE; // previous transfer never completed
+    io->tx_start_us = esp_timer_get_time();
+    esp_err_t err = i2c_master_transmit(io->dev, data, len, LCD_I2C_TIMEOUT_MS);
+    if (err == ESP_OK && io->async) {
+        io->tx_busy = true;
+    } else if (!io->async) {
+        io->base.bus_time_us += (uint32_t)(esp_timer_get_time() - io->tx_start_us);
+    }
+    return err;
+}// eo _i2c_transmit::
+
+/*>>> _i2c_now_us: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will return the esp_timer time.
+Input: 		- base: Pointer to the I²C transport (unused)
+Returns:	Microseconds since boot.
+ ============================================================================*/
+static int64_t _i2c_now_us(lcd20x4_transport_t *base) {
+    return esp_timer_get_time();
+}// eo _i2c_now_us::
+
+/*>>> _i2c_sleep_until: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will wait until the given deadline. Long waits block
+			the task (vTaskDelay), so the CPU is free for other tasks; only the
+			sub-millisecond tail is spun.
+Input: 		- base: Pointer to the I²C transport (unused)
+			- deadline_us: esp_timer time to wait for
+Returns:	None
+ ============================================================================*/
+static void _i2c_sleep_until(lcd20x4_transport_t *base, int64_t deadline_us) {
+    int64_t remaining = deadline_us - esp_timer_get_time();
+    while (remaining >= LCD_YIELD_MIN_US) {
+        // a one-tick delay may end early (partial tick), so re-check afterwards
+        TickType_t ticks = pdMS_TO_TICKS(remaining / 1000);
+        vTaskDelay(ticks ? ticks : 1);
+        remaining = deadline_us - esp_timer_get_time();
+    }
+    if (remaining > 0) {
+        esp_rom_delay_us((uint32_t)remaining);
+    }
+}// eo _i2c_sleep_until::
+
+/*>>> lcd20x4_i2c_open: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+Desc:		This function will add the PCF8574 to the bus and set up the
+			transport. Completion callbacks are only accepted on an
+			asynchronous bus; without one every transfer is synchronous.
+Input: 		- io: Pointer to the transport to set up
+			- bus: Shared I²C master bus handle
+			- clk_speed: SCL speed for this device in Hz
+			- addr: 7-bit PCF8574 address
+Returns:	ESP_OK on success, or an error code on failure.
+ ============================================================================*/
+esp_err_t lcd20x4_i2c_open(lcd20x4_i2c_t *io, i2c_master_bus_handle_t bus, uint32_t clk_speed, uint8_t addr) {
+    io->base.transmit    = _i2c_transmit;
+    io->base.wait        = _i2c_wait;
+    io->base.now_us      = _i2c_now_us;
+    io->base.sleep_until = _i2c_sleep_until;
+    io->base.bus_time_us = 0;
+    io->tx_busy          = false;
+    io->bus              = bus;
+
+    i2c_device_config_t dev_cfg = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address  = addr,
+        .scl_speed_hz    = clk_speed,
+    };
+    esp_err_t err = i2c_master_bus_add_device(bus, &dev_cfg, &io->dev);
+    if (err != ESP_OK) return err;
+
+    io->tx_done = xSemaphoreCreateBinaryStatic(&io->tx_done_buf);
+    i2c_master_event_callbacks_t cbs = { .on_trans_done = _on_trans_done };
+    io->async = (i2c_master_register_event_callbacks(io->dev, &cbs, io) == ESP_OK);
+    return ESP_OK;
+}// eo lcd20x4_i2c_open::
+
+/*>>> lcd20x4_init: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		10/07/2025
+Modified:	17/10/2026
+Desc:		This function will attach the LCD to an I²C master bus and
+			initialize it through the driver's own I²C transport.
+Input: 		- lcd: Pointer to the LCD driver structure
+			- bus: Shared I²C master bus handle
+			- clk_speed: SCL speed for this device in Hz
+			- lcd_addr: 7-bit PCF8574 address
+Returns:	ESP_OK on success, or an error code on failure.
+ ============================================================================*/
+esp_err_t lcd20x4_init(lcd_20x4_driver_t *lcd,
+                       i2c_master_bus_handle_t bus,
+                       uint32_t clk_speed,
+                       uint8_t lcd_addr,
+                       bool backlight,
+                       uint8_t rows,
+                       uint8_t cols)
+{
+    lcd->address = lcd_addr;
+    esp_err_t err = lcd20x4_i2c_open(&lcd->i2c, bus, clk_speed, lcd_addr);
+    if (err != ESP_OK) return err;
+    return lcd20x4_init_io(lcd, &lcd->i2c.base, backlight, rows, cols);
+}// eo lcd20x4_init::
@@ -0,0 +1,45 @@
+/*======================================================================================================
+File Name:	lcd_20x4_i2c.h
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the interface for the I²C transport of the LCD 20x4 driver,
+which writes to the PCF8574 through the ESP-IDF i2c_master driver.
+====================================================================================================*/
+
+// lcd_20x4_i2c.h
+#ifndef LCD_20X4_I2C_H
+#define LCD_20X4_I2C_H
+
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "driver/i2c_master.h"
+#include "lcd_20x4_transport.h"
+
+#define LCD_I2C_TIMEOUT_MS      100  // Per-transfer timeout
+#define LCD_YIELD_MIN_US        1000 // Waits at least this long yield to FreeRTOS instead of spinning
+
+typedef struct {
+    lcd20x4_transport_t base;        // must be first
+    i2c_master_bus_handle_t bus;     // shared bus, drained when a completion is late
+    i2c_master_dev_handle_t dev;     // PCF8574 on the shared bus
+    // asynchronous transfer state (bus created with trans_queue_depth > 0)
+    bool              async;         // transfers complete in the background
+    bool              tx_busy;       // a transfer is still queued
+    volatile esp_err_t tx_err;       // result reported by the completion callback
+    int64_t           tx_start_us;   // submit timestamp of the in-flight transfer
+    SemaphoreHandle_t tx_done;       // given by the completion callback
+    StaticSemaphore_t tx_done_buf;   // storage for tx_done
+} lcd20x4_i2c_t; // I²C transport
+
+/**
+ * @brief Add the PCF8574 at `addr` to `bus` and set up `io` as its transport.
+ *        On a bus created with trans_queue_depth > 0 transfers are queued
+ *        and complete in the background.
+ */
+esp_err_t lcd20x4_i2c_open(lcd20x4_i2c_t *io, i2c_master_bus_handle_t bus, uint32_t clk_speed, uint8_t addr);
+
+#endif // LCD_20X4_I2C_H
@@ -0,0 +1,41 @@
+/*======================================================================================================
+File Name:	lcd_20x4_transport.h
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the transport interface the LCD 20x4 driver writes through.
+The driver only encodes PCF8574 byte streams and tracks HD44780 deadlines; moving the bytes and
+keeping time is left to a transport, so the same driver runs on the I²C bus (lcd_20x4_i2c.c)
+or against the host-side emulator (lcd_20x4_emu.c).
+====================================================================================================*/
+
+// lcd_20x4_transport.h
+#ifndef LCD_20X4_TRANSPORT_H
+#define LCD_20X4_TRANSPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef struct lcd20x4_transport lcd20x4_transport_t;
+
+/**
+ * @brief Byte sink + clock under the LCD driver.
+ * Implementations embed this as their first member.
+ */
+struct lcd20x4_transport {
+    /// Start writing `len` PCF8574 bytes as one transaction. May return before
+    /// they are on the wire; `data` must then stay untouched until wait().
+    esp_err_t (*transmit)(lcd20x4_transport_t *io, const uint8_t *data, size_t len);
+    /// Block until the last transmit() has left the bus and return its result.
+    esp_err_t (*wait)(lcd20x4_transport_t *io);
+    /// Current time in µs, used for HD44780 execution deadlines.
+    int64_t   (*now_us)(lcd20x4_transport_t *io);
+    /// Return once now_us() has reached `deadline_us`.
+    void      (*sleep_until)(lcd20x4_transport_t *io, int64_t deadline_us);
+    uint32_t  bus_time_us; // time spent on the wire, accumulated by the transport
+};
+
+#endif // LCD_20X4_TRANSPORT_H
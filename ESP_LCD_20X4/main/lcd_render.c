@@ -0,0 +1,195 @@
+/*======================================================================================================
+File Name:	lcd_render.c
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the implementation of the LCD render task. Producers copy a
+complete frame into a panel's pending buffer and return; the render task moves it into that
+driver's framebuffer and commits it, so no I²C latency is ever spent on the producer's stack.
+Panels are served round-robin and each turn sends at most LCD_RENDER_QUANTUM bytes, so a full
+redraw of one panel cannot hold back small updates on the others.
+====================================================================================================*/
+
+#include "lcd_render.h"
+#include <string.h>
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+
+static const char *TAG = "LCD_RENDER";
+
+typedef struct {
+    lcd_20x4_driver_t *lcd;          // driver owned by the render task
+    lcd20x4_frame_t    pending;      // back buffer: latest published frame
+    bool               has_pending;  // true until the task picks it up
+    bool               flushing;     // framebuffer still differs from the panel
+} render_panel_t; // One panel served by the render task
+
+static TaskHandle_t       s_task;         // render task handle
+static SemaphoreHandle_t  s_lock;         // guards s_panels[].pending / has_pending, s_count
+static render_panel_t     s_panels[LCD_RENDER_MAX_PANELS];
+static uint8_t            s_count;        // panels in use
+
+/*>>> render_turn: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will give one panel its turn: pick up a newly
+			published frame, then send up to one quantum of its changed runs.
+			A timed-out transfer keeps the panel flushing, so its next turn
+			retries (the driver then redraws it in full) instead of leaving it
+			half-drawn until the next publish.
+Input: 		- p: Panel to serve
+Returns:	true if the panel still has changes to send.
+ ============================================================================*/
+static bool render_turn(render_panel_t *p)
+{
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (p->has_pending) {
+        p->lcd->fb     = p->pending;
+        p->has_pending = false;
+        p->flushing    = true;
+    }
+    xSemaphoreGive(s_lock);
+    if (!p->flushing) return false;
+
+    bool more = false;
+    esp_err_t err = lcd20x4_commit_step(p->lcd, LCD_RENDER_QUANTUM, &more);
+    if (err == ESP_ERR_TIMEOUT) {
+        ESP_LOGW(TAG, "commit timed out, retrying");
+        more = true;
+    } else if (err != ESP_OK) {
+        ESP_LOGW(TAG, "commit failed, redrawing next frame in full");
+        lcd20x4_invalidate(p->lcd);
+        more = false;
+    }
+    p->flushing = more;
+    return more;
+}// eo render_turn::
+
+/*>>> render_task: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This task sleeps until a frame is published, then serves the panels
+			round-robin until every framebuffer has reached its panel.
+Input: 		- arg: Unused
+Returns:	None
+ ============================================================================*/
+static void render_task(void *arg)
+{
+    (void)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        bool busy;
+        do {
+            busy = false;
+            for (uint8_t i = 0; i < s_count; i++) {
+                busy |= render_turn(&s_panels[i]);
+            }
+        } while (busy);
+    }
+}// eo render_task::
+
+/*>>> lcd_render_add_panel: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will hand another panel to the render task.
+Input: 		- lcd: Pointer to the initialised LCD driver structure
+			- panel: Receives the panel index
+Returns:	ESP_OK on success, ESP_ERR_INVALID_STATE before lcd_render_start(),
+			or ESP_ERR_NO_MEM if all panels are in use.
+ ============================================================================*/
+esp_err_t lcd_render_add_panel(lcd_20x4_driver_t *lcd, uint8_t *panel)
+{
+    if (s_lock == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t err = ESP_ERR_NO_MEM;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (s_count < LCD_RENDER_MAX_PANELS) {
+        render_panel_t *p = &s_panels[s_count];
+        memset(p, 0, sizeof(*p));
+        p->lcd = lcd;
+        if (panel) *panel = s_count;
+        s_count++;
+        err = ESP_OK;
+    }
+    xSemaphoreGive(s_lock);
+    return err;
+}// eo lcd_render_add_panel::
+
+/*>>> lcd_render_start: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will start the render task and hand it the driver
+			as panel 0.
+Input: 		- lcd: Pointer to the initialised LCD driver structure
+Returns:	ESP_OK on success, or an error code on failure.
+ ============================================================================*/
+esp_err_t lcd_render_start(lcd_20x4_driver_t *lcd)
+{
+    s_lock = xSemaphoreCreateMutex();
+    if (!s_lock) {
+        return ESP_ERR_NO_MEM;
+    }
+    s_count = 0;
+    esp_err_t err = lcd_render_add_panel(lcd, NULL);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (xTaskCreate(render_task, "lcd_render", LCD_RENDER_STACK, NULL,
+                    LCD_RENDER_PRIORITY, &s_task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}// eo lcd_render_start::
+
+/*>>> lcd_render_publish_to: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will copy a frame into a panel's pending buffer,
+			replacing any frame the render task has not picked up yet, and wake
+			the task.
+Input: 		- panel: Panel index
+			- frame: Pointer to the frame to publish
+Returns:	ESP_OK, ESP_ERR_INVALID_STATE if the render task is not running, or
+			ESP_ERR_INVALID_ARG for an unknown panel.
+ ============================================================================*/
+esp_err_t lcd_render_publish_to(uint8_t panel, const lcd20x4_frame_t *frame)
+{
+    if (s_task == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t err = ESP_ERR_INVALID_ARG;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (panel < s_count) {
+        s_panels[panel].pending     = *frame;
+        s_panels[panel].has_pending = true;
+        err = ESP_OK;
+    }
+    xSemaphoreGive(s_lock);
+    if (err == ESP_OK) {
+        xTaskNotifyGive(s_task);
+    }
+    return err;
+}// eo lcd_render_publish_to::
+
+/*>>> lcd_render_publish: ==========================================================
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+Desc:		This function will publish a frame for panel 0.
+Input: 		- frame: Pointer to the frame to publish
+Returns:	As lcd_render_publish_to().
+ ============================================================================*/
+esp_err_t lcd_render_publish(const lcd20x4_frame_t *frame)
+{
+    return lcd_render_publish_to(0, frame);
+}// eo lcd_render_publish::
@@ -0,0 +1,62 @@
+/*======================================================================================================
+File Name:	lcd_render.h
+Author:		Vamseedhar Reddy, Samip Patel
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the interface for the LCD render task, which owns the
+LCD drivers and draws the latest frame published for each panel. Several panels on one
+bus are flushed round-robin, a bounded amount of traffic per panel per turn.
+====================================================================================================*/
+
+#ifndef LCD_RENDER_H
+#define LCD_RENDER_H
+
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+#include "lcd_20x4_driver.h"
+
+#define LCD_RENDER_STACK      3072 // Render task stack size
+#define LCD_RENDER_PRIORITY   4    // Below the network tasks
+#define LCD_RENDER_MAX_PANELS 4    // Panels one render task can drive
+// Traffic a panel may send per turn: one full row (address + 20 cells).
+// A frame update on one panel waits for at most
+// (LCD_RENDER_MAX_PANELS - 1) * LCD_RENDER_QUANTUM bytes of other panels' traffic per turn.
+#define LCD_RENDER_QUANTUM    ((LCD_COLS_MAX + 1) * LCD_BYTES_PER_CHAR)
+
+/**
+ * @brief Start the render task with `lcd` as panel 0. From now on the task
+ *        owns `lcd`; no other task may call the driver directly.
+ * @param lcd   Initialised driver (must outlive the task).
+ * @return ESP_OK, or ESP_ERR_NO_MEM if the task could not be created or
+ *         no panel slot was free.
+ */
+esp_err_t lcd_render_start(lcd_20x4_driver_t *lcd);
+
+/**
+ * @brief Hand another initialised panel (e.g. a second PCF8574 address on the
+ *        same bus) to the render task.
+ * @param lcd    Initialised driver (must outlive the task).
+ * @param panel  Receives the index to publish to.
+ * @return ESP_OK, ESP_ERR_INVALID_STATE before lcd_render_start(), or
+ *         ESP_ERR_NO_MEM if LCD_RENDER_MAX_PANELS are in use.
+ */
+esp_err_t lcd_render_add_panel(lcd_20x4_driver_t *lcd, uint8_t *panel);
+
+/**
+ * @brief Publish a complete frame for one panel and return immediately. If
+ *        that panel is still being drawn, only the latest frame published
+ *        is drawn (latest frame wins).
+ * @param panel Index from lcd_render_add_panel() (0 = the first panel).
+ * @param frame Frame to copy.
+ * @return ESP_OK, ESP_ERR_INVALID_STATE before lcd_render_start() has
+ *         succeeded, or ESP_ERR_INVALID_ARG for an unknown panel.
+ */
+esp_err_t lcd_render_publish_to(uint8_t panel, const lcd20x4_frame_t *frame);
+
+/// Publish a complete frame for panel 0 (see lcd_render_publish_to()).
+esp_err_t lcd_render_publish(const lcd20x4_frame_t *frame);
+
+#endif // LCD_RENDER_H
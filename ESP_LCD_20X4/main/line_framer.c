@@ -0,0 +1,169 @@
+/*======================================================================================================
+File Name:	line_framer.c
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the implementation of the line framer.
+====================================================================================================*/
+
+#include "line_framer.h"
+#include <string.h>
+
+/*>>> line_framer_reset: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: 17/10/2026
+Desc: Forget any partial record.
+Input: line_framer_t *f - Framer.
+Return: None
+=========================================================================================================*/
+void line_framer_reset(line_framer_t *f)
+{
+    f->len      = 0;
+    f->overflow = false;
+    f->bin_cur  = 0;
+    f->dropped  = 0;
+} // eo line_framer_reset::
+
+/*>>> line_framer_set_binary: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Accept fixed-length binary records introduced by a sync byte (re-registering a sync byte
+      changes its length).
+Input: line_framer_t *f - Framer.
+       uint8_t sync - First byte of every record of this type.
+       size_t len - Record length.
+Return: bool - false if the table is full or len is out of range.
+=========================================================================================================*/
+bool line_framer_set_binary(line_framer_t *f, uint8_t sync, size_t len)
+{
+    if (len == 0 || len > LINE_FRAMER_MAX) return false;
+    int k = 0;
+    while (k < f->bin_kinds && f->bin_sync[k] != sync) k++;
+    if (k == LINE_FRAMER_BIN_KINDS) return false;
+    f->bin_sync[k] = sync;
+    f->bin_len[k]  = len;
+    if (k == f->bin_kinds) f->bin_kinds++;
+    return true;
+} // eo line_framer_set_binary::
+
+/*>>> binary_len: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Length of the binary record type that starts with `first`.
+Input: const line_framer_t *f - Framer.
+       uint8_t first - First byte of a record.
+Return: uint8_t - Record length, 0 if it is not a binary sync byte.
+=========================================================================================================*/
+static uint8_t binary_len(const line_framer_t *f, uint8_t first)
+{
+    for (int k = 0; k < f->bin_kinds; k++)
+    {
+        if (f->bin_sync[k] == first) return f->bin_len[k];
+    }
+    return 0;
+} // eo binary_len::
+
+/*>>> line_framer_feed: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: 17/10/2026
+Desc: Append received bytes and hand every completed record to the callback. Records longer than
+      LINE_FRAMER_MAX are dropped whole rather than truncated. A binary record is recognised by its
+      sync byte at a record boundary and copied without looking for terminators.
+Input: line_framer_t *f - Framer.
+       const char *data - Received bytes.
+       size_t len - Number of bytes.
+       line_framer_cb_t cb - Record handler.
+       void *ctx - Passed to cb.
+Return: None
+=========================================================================================================*/
+void line_framer_feed(line_framer_t *f, const char *data, size_t len, line_framer_cb_t cb, void *ctx)
+{
+    while (len > 0)
+    {
+        if (!f->bin_cur && f->len == 0 && !f->overflow)
+        {
+            f->bin_cur = binary_len(f, (uint8_t)data[0]);
+        }
+        if (f->bin_cur)
+        {
+            size_t take = f->bin_cur - f->len;
+            if (take > len) take = len;
+            memcpy(f->buf + f->len, data, take);
+            f->len += take;
+            if (f->len == f->bin_cur)
+            {
+                cb(f->buf, f->len, ctx);
+                f->len     = 0;
+                f->bin_cur = 0;
+            }
+            data += take;
+            len  -= take;
+            continue;
+        }
+
+        const char *nl = memchr(data, '\n', len);
+        size_t take = nl ? (size_t)(nl - data) : len;
+
+        // append up to the terminator (or everything if there is none yet)
+        if (!f->overflow)
+        {
+            if (f->len + take > LINE_FRAMER_MAX)
+            {
+                f->overflow = true;
+            }
+            else
+            {
+                memcpy(f->buf + f->len, data, take);
+                f->len += take;
+            }
+        }
+        if (!nl) return; // record continues in the next segment
+
+        if (f->overflow)
+        {
+            f->dropped++;
+        }
+        else
+        {
+            if (f->len > 0 && f->buf[f->len - 1] == '\r') f->len--;
+            f->buf[f->len] = '\0';
+            if (f->len > 0) cb(f->buf, f->len, ctx);
+        }
+        f->len      = 0;
+        f->overflow = false;
+        data += take + 1;
+        len  -= take + 1;
+    }
+} // eo line_framer_feed::
+
+/*>>> line_framer_flush: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: 17/10/2026
+Desc: Treat the end of the stream as a terminator for whatever is buffered. A partial binary record
+      is dropped.
+Input: line_framer_t *f - Framer.
+       line_framer_cb_t cb - Record handler.
+       void *ctx - Passed to cb.
+Return: None
+=========================================================================================================*/
+void line_framer_flush(line_framer_t *f, line_framer_cb_t cb, void *ctx)
+{
+    if (f->bin_cur)
+    {
+        f->dropped++;
+        f->len     = 0;
+        f->bin_cur = 0;
+        return;
+    }
+    if (f->len > 0 || f->overflow)
+    {
+        line_framer_feed(f, "\n", 1, cb, ctx);
+    }
+} // eo line_framer_flush::
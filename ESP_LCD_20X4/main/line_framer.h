@@ -0,0 +1,61 @@
+/*======================================================================================================
+File Name:	line_framer.h
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the interface for the line framer, which turns a TCP byte stream
+into newline-terminated records regardless of how the stream was split into segments. A framer can
+also accept fixed-length binary records that start with a sync byte, so one port can take text and
+binary clients.
+====================================================================================================*/
+
+#ifndef LINE_FRAMER_H
+#define LINE_FRAMER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define LINE_FRAMER_MAX     64  // Longest record kept, excluding the terminator
+#define LINE_FRAMER_BIN_KINDS 2 // Binary record types a framer can accept
+
+/// Called once per complete record; `line` is NUL-terminated, without CR/LF.
+/// Binary records are passed as is (`len` bytes, starting with the sync byte).
+typedef void (*line_framer_cb_t)(const char *line, size_t len, void *ctx);
+
+typedef struct {
+    char   buf[LINE_FRAMER_MAX + 1]; // record being assembled
+    size_t len;                      // bytes in buf
+    bool   overflow;                 // current record too long: drop it up to the next '\n'
+    uint8_t bin_cur;                 // length of the binary record being read, 0 = text
+    uint8_t bin_kinds;               // binary record types accepted
+    uint8_t bin_sync[LINE_FRAMER_BIN_KINDS]; // first byte of each type
+    uint8_t bin_len[LINE_FRAMER_BIN_KINDS];  // length of each type
+    unsigned dropped;                // records dropped for being too long (or cut short)
+} line_framer_t; // Per-connection framing state
+
+/// Forget any partial record (e.g. when a new connection starts).
+void line_framer_reset(line_framer_t *f);
+
+/**
+ * @brief Also accept binary records: a record that starts with `sync` is taken
+ *        as exactly `len` bytes (≤ LINE_FRAMER_MAX) with no terminator. Text
+ *        records must then never start with `sync`. Up to LINE_FRAMER_BIN_KINDS
+ *        sync bytes may be registered; survives line_framer_reset().
+ * @return false if the table is full or `len` is out of range
+ */
+bool line_framer_set_binary(line_framer_t *f, uint8_t sync, size_t len);
+
+/**
+ * @brief Feed received bytes. A record may be split over several calls and
+ *        one call may complete several records; `cb` runs for each complete,
+ *        non-empty one. "\r\n" and "\n" both terminate a record.
+ */
+void line_framer_feed(line_framer_t *f, const char *data, size_t len, line_framer_cb_t cb, void *ctx);
+
+/// Deliver a trailing record that was not newline-terminated (e.g. at EOF).
+void line_framer_flush(line_framer_t *f, line_framer_cb_t cb, void *ctx);
+
+#endif // LINE_FRAMER_H
@@ -2,7 +2,7 @@
 File Name:	main.c
 Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
 Date:		17/07/2025
-Modified:	29/07/2025
+Modified:	17/10/2026
 © Fanshawe College, 2025
 
 Description: This file contains the main application logic for the Smart shelf Inventory Management project for its Primary Controller,
@@ -17,17 +17,22 @@ including initialization, task management, and event handling.
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "driver/gpio.h"
+#include "driver/i2c_master.h"
 #include "esp_system.h"
 #include "esp_log.h"
 #include "nvs_flash.h"
 #include "esp_netif.h"
 #include "esp_wifi.h"
 #include "esp_event.h"
-#include "lwip/sockets.h"
 
+#include "buttons.h"
 #include "item_sorting.h"
 #include "lcd_20x4_driver.h"
+#include "net_reactor.h"
+#include "scan_pipeline.h"
+#include "sensor_frame.h"
 #include "shelf_manager.h"
+#include "view_manager.h"
 
 static const char *TAG      = "BARCODE_TEST";
 static const char *TAG_SENS = "SENSOR_LISTENER";
@@ -36,10 +41,22 @@ static const char *TAG_SENS = "SENSOR_LISTENER";
 #define AP_PASS     "test1234"    // Access Point Password
 #define TCP_PORT    3334           // TCP port for barcode scans
 #define SENS_PORT   3333           // TCP port for occupancy + T/H + spill
+#define SCAN_IDLE_MS   300000      // Close a silent scanner session after 5 min
+#define SENS_IDLE_MS   10000       // Close a silent transmitter after 10 s
+#define NET_TICK_MS    1000        // Reactor wake-up for idle-timeout sweeps
+
+// I2C bus (shared by the LCD and any other I2C peripherals)
+#define I2C_SDA_GPIO        GPIO_NUM_21
+#define I2C_SCL_GPIO        GPIO_NUM_22
+#define I2C_CLK_HZ          100000
+#define I2C_TRANS_QUEUE     4     // >0 → asynchronous transfers
+#define LCD_I2C_ADDR        0x27
 
 // Buttons
 #define SW1_GPIO    GPIO_NUM_2    // toggle scan mode
-#define SW2_GPIO    GPIO_NUM_5    // re‑display last scan
+#define SW2_GPIO    GPIO_NUM_5    // re‑display last scan (long press: pipeline counters)
+#define BTN_SW1     0             // button_event_t.button indices
+#define BTN_SW2     1
 
 // LED indicators
 #define LED_TEMP_GPIO   GPIO_NUM_12 // Temperature LED
@@ -50,74 +67,15 @@ static const char *TAG_SENS = "SENSOR_LISTENER";
 #define TEMP_LIMIT      25.0f  // °C
 #define HUM_LIMIT       90.0f  // %
 
-#define DEGREE_SYMBOL   0xDF   // custom ° character code for LCD
-
-// Your LG_spill slot lives at index 9 (0–9 total slots)
-#define LG_SPILL_INDEX 9 // Large liquid spill slot
+// Toast hold times
+#define TOAST_ABORT_MS  1000 // aborted scan
+#define TOAST_STATS_MS  3000 // scan pipeline counters
 
-static item_info_t  s_last_info; // Last scanned item information
-static char         s_last_code[16]; // Last scanned barcode
-static bool         s_has_last   = false; // Flag for last scan presence
-static int          s_last_slot  = -1; // Last occupied slot
 static float        s_temp       = 0.0f; // Current temperature
 static float        s_hum        = 0.0f; // Current humidity
 static bool         s_spill      = false;
-
-// ─── Helpers ─────────────────────────────────────────────────────────────────
-/*>>> is_digits: ======================================================================
-Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
-Date: 17/07/2025
-Modified: 27/07/2025
-Desc: Check if a string consists only of digits.
-Input: const char *s - The input string to check.
-Return: bool - True if the string is all digits, false otherwise.
-=========================================================================================================*/
-static bool is_digits(const char *s) 
-{
-    for (; *s; ++s) if (*s < '0' || *s > '9') return false;
-    return true;
-} // eo is_digits::
-
-/*>>> decode_size: ======================================================================
-Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
-Date: 17/07/2025
-Modified: 29/07/2025
-Desc: Decode a character into an item size.
-Input: char d - The character to decode.
-Return: item_size_t - The decoded item size.
-=========================================================================================================*/
-static item_size_t  decode_size(char d)  
-{
-    if      (d >= '0' && d <= '2') return SIZE_SMALL;
-    else if (d >= '3' && d <= '6') return SIZE_MEDIUM;
-    else                            return SIZE_LARGE;
-} // eo decode_size::
-
-/*>>> decode_type: ======================================================================
-Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
-Date: 17/07/2025
-Modified: 29/07/2025
-Desc: Decode a character into an item type.
-Input: char d - The character to decode.
-Return: item_type_t - The decoded item type.
-=========================================================================================================*/
-static item_type_t  decode_type(char d)  
-{
-    return (d=='0') ? TYPE_FROZEN : TYPE_DRY;
-} // eo decode_type::
-
-/*>>> decode_phase: ======================================================================
-Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
-Date: 17/07/2025
-Modified: 29/07/2025
-Desc: Decode a character into an item phase.
-Input: char d - The character to decode.
-Return: item_phase_t - The decoded item phase.
-=========================================================================================================*/
-static item_phase_t decode_phase(char d) 
-{
-    return (d <= '5') ? PHASE_LIQUID : PHASE_SOLID;
-} // eo decode_phase::
+static uint16_t     s_occupancy  = 0;     // last applied occupancy, bit i = slot i
+static volatile bool s_scanning  = false; // SW1 scan mode (written by ui_task, read by the reactor)
 
 // ─── Wi‑Fi SoftAP ─────────────────────────────────────────────────────────────
 /*>>> wifi_init_softap: ======================================================================
@@ -158,25 +116,32 @@ static void wifi_init_softap(void) // Initialize Wi‑Fi in SoftAP mode
 Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
 Date: 17/07/2025
 Modified: 27/07/2025
-Desc: Initialize peripherals (LCD, buttons, LEDs) and operate the logic accordingly for user interaction.
+Desc: Initialize peripherals (I2C bus, LCD, buttons, LEDs) and operate the logic accordingly for user interaction.
 Input: lcd_20x4_driver_t *lcd - Pointer to the LCD driver.
 Return: None
 =========================================================================================================*/
 static void peripherals_init(lcd_20x4_driver_t *lcd) {
-    // LCD
-    ESP_ERROR_CHECK(lcd20x4_init(lcd,I2C_NUM_0,GPIO_NUM_21, GPIO_NUM_22, 100000, 0x27, true, 4, 20));
-    lcd20x4_clear(lcd);
-    lcd20x4_set_cursor(lcd,0,0); lcd20x4_write_string(lcd,"Barcode Sorting");
-    lcd20x4_set_cursor(lcd,0,1); lcd20x4_write_string(lcd,"Waiting for scan:");
-
-    // Buttons
-    gpio_config_t btn = 
+    // I2C master bus, created once and shared by every device on it
+    static i2c_master_bus_handle_t bus;
+    i2c_master_bus_config_t bus_cfg = 
     {
-        .pin_bit_mask = (1ULL<<SW1_GPIO)|(1ULL<<SW2_GPIO),
-        .mode         = GPIO_MODE_INPUT,
-        .pull_up_en   = GPIO_PULLUP_ENABLE,
+        .i2c_port          = I2C_NUM_0,
+        .sda_io_num        = I2C_SDA_GPIO,
+        .scl_io_num        = I2C_SCL_GPIO,
+        .clk_source        = I2C_CLK_SRC_DEFAULT,
+        .glitch_ignore_cnt = 7,
+        .trans_queue_depth = I2C_TRANS_QUEUE,
+        .flags.enable_internal_pullup = true,
     };
-    gpio_config(&btn);
+    ESP_ERROR_CHECK(i2c_new_master_bus(&bus_cfg, &bus));
+
+    // LCD
+    ESP_ERROR_CHECK(lcd20x4_init(lcd, bus, I2C_CLK_HZ, LCD_I2C_ADDR, true, 4, 20));
+    ESP_ERROR_CHECK(view_init(lcd)); // render task owns the LCD from here on
+
+    // Buttons (interrupt driven, events are consumed by ui_task)
+    static const gpio_num_t buttons[] = { [BTN_SW1] = SW1_GPIO, [BTN_SW2] = SW2_GPIO };
+    ESP_ERROR_CHECK(buttons_init(buttons, sizeof(buttons) / sizeof(buttons[0])));
 
     // LEDs
     gpio_config_t led_cfg = 
@@ -191,255 +156,262 @@ static void peripherals_init(lcd_20x4_driver_t *lcd) {
     gpio_set_level(LED_SPILL_GPIO, 0);
 }
 
-// ─── Scan Task ─────────────────────────────────────────────────────────────────
-/*>>> scan_task: ======================================================================
+// ─── Scan Handling ─────────────────────────────────────────────────────────────
+/*>>> on_scan_line: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: 17/10/2026
+Desc: Record handler for the scan port: hand the barcode to the scan pipeline, which acknowledges it.
+Input: net_conn_t *conn - Scanner connection.
+       const char *line - Barcode.
+       size_t len - Length of line.
+       void *ctx - Unused.
+Return: None
+=========================================================================================================*/
+static void on_scan_line(net_conn_t *conn, const char *line, size_t len, void *ctx)
+{
+    scan_pipeline_ingest(conn, line, len, s_scanning);
+}// eo on_scan_line::
+
+// ─── Sensor Handling ──────────────────────────────────────────────────────────
+/*>>> parse_sensor_csv: ======================================================================
 Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
 Date: 17/07/2025
-Modified: 29/07/2025
-Desc: Task to handle barcode scanning, including TCP connection handling for barcode data, Temperature and Humidity readings.
-Input: void *arg - Pointer to the LCD driver.
+Modified: 17/10/2026
+Desc: Compatibility mode: parse one "P0..P9,SPILL,TEMP,HUM" CSV record (formerly the body of
+      sensor_task) into the same form as a binary frame.
+Input: const char *line - CSV record.
+       size_t len - Length of line.
+       sensor_frame_t *out - Parsed sample.
 Return: None
 =========================================================================================================*/
-static void scan_task(void *arg) 
+static void parse_sensor_csv(const char *line, size_t len, sensor_frame_t *out)
 {
-    lcd_20x4_driver_t *lcd = arg;
-    struct sockaddr_in addr = 
+    char buf[LINE_FRAMER_MAX + 1];
+    memcpy(buf, line, len + 1); // strtok needs a writable copy
+    memset(out, 0, sizeof(*out));
+
+    // 1) occupancy
+    char *tok = strtok(buf, ",");
+    for (int i=0;i<SHELF_SLOTS && tok;++i) 
     {
-        .sin_family      = AF_INET,
-        .sin_port        = htons(TCP_PORT),
-        .sin_addr.s_addr = htonl(INADDR_ANY),
-    };
-    int ls = socket(AF_INET, SOCK_STREAM, IPPROTO_IP);
-    setsockopt(ls, SOL_SOCKET, SO_REUSEADDR, &(int){1}, sizeof(int));
-    bind(ls, (struct sockaddr*)&addr, sizeof(addr));
-    listen(ls, 1);
+        if (tok[0]=='1') out->occupancy |= 1u << i;
+        tok   = strtok(NULL,",");
+    }
 
-    bool scanning = false;
-    for (;;) // similar to while(1) but can be changed later according to needs 
+    // 2) spill
+    if (tok) 
     {
-        // ── Idle: show live T/H ─────────────────────────
-        if (!scanning)
-        {
-            char l2[21], l3[21];
-            snprintf(l2, sizeof(l2), "Temp: %.1f%cC", s_temp, DEGREE_SYMBOL); // snprintf is used for safe string formatting to avoid buffer overflows
-            snprintf(l3, sizeof(l3), "Hum:  %.1f %%",    s_hum);
-            lcd20x4_set_cursor(lcd,0,2); 
-            lcd20x4_write_string(lcd,l2);
-            lcd20x4_set_cursor(lcd,0,3); 
-            lcd20x4_write_string(lcd,l3);
-            vTaskDelay(pdMS_TO_TICKS(1000)); // delay for 1 second
-        }
+        out->spill = (tok[0]=='1');
+        tok = strtok(NULL,",");
+    }
 
-        // ── SW1 toggles scan mode ────────────────────────
-        if (gpio_get_level(SW1_GPIO)==0) 
-        {
-            scanning = !scanning;
-            ESP_LOGI(TAG,"SW1 → scanning=%d", scanning);
-            while (gpio_get_level(SW1_GPIO)==0) vTaskDelay(10);
-            lcd20x4_clear(lcd);
-            if (scanning) 
-            {
-                lcd20x4_set_cursor(lcd,0,0); lcd20x4_write_string(lcd,"Scan mode:");
-                lcd20x4_set_cursor(lcd,0,1); lcd20x4_write_string(lcd,"Waiting for TCP");
-            } else 
-            {
-                lcd20x4_set_cursor(lcd,0,0); lcd20x4_write_string(lcd,"Aborted scan");
-                vTaskDelay(pdMS_TO_TICKS(1000));
-                lcd20x4_clear(lcd);
-                lcd20x4_set_cursor(lcd,0,0); lcd20x4_write_string(lcd,"Barcode Sorting");
-                lcd20x4_set_cursor(lcd,0,1); lcd20x4_write_string(lcd,"Waiting for scan:");
-            }
-        }
-        if (!scanning) 
-        { 
-            vTaskDelay(pdMS_TO_TICKS(50)); continue; 
-        }
+    // 3) temp
+    float t=0,h=0;
+    if (tok) 
+    {
+        t = strtof(tok, &tok);
+    }
+    // 4) hum
+    if (tok) 
+    {
+        h = strtof(tok+1, NULL);
+    }
+    out->temp_c = sensor_frame_centi(t);
+    out->hum_c  = sensor_frame_centi(h);
+}// eo parse_sensor_csv::
+
+/*>>> apply_occupancy: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Hand an occupancy bitmask to the shelf.
+Input: uint16_t occ - Bit i = slot i occupied.
+Return: None
+=========================================================================================================*/
+static void apply_occupancy(uint16_t occ)
+{
+    bool ir[SHELF_SLOTS];
+    for (int i=0;i<SHELF_SLOTS;++i) 
+    {
+        ir[i] = (occ >> i) & 1;
+    }
+    scan_pipeline_update_occupancy(ir);
+    s_occupancy = occ;
+}// eo apply_occupancy::
 
-        // ── Accept one barcode ───────────────────────────
-        int acceptbar = accept(ls, NULL, NULL);
-        if (acceptbar<0) 
-        { 
-            vTaskDelay(pdMS_TO_TICKS(50)); 
-            continue; 
+/*>>> check_seq: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: 17/10/2026
+Desc: Log gaps in the sequence shared by snapshot and delta frames. A lost delta is repaired by the
+      next snapshot. Each transmitter numbers its own frames, so the last sequence number is kept
+      with its connection (bit 16 = one has been seen, low 16 bits = the number).
+Input: net_conn_t *conn - Transmitter connection.
+       uint16_t seq - Sequence number of the frame just received.
+Return: None
+=========================================================================================================*/
+static void check_seq(net_conn_t *conn, uint16_t seq)
+{
+    uint32_t *last = net_conn_user(conn);
+    if ((*last & 0x10000u) && (uint16_t)(seq - (uint16_t)*last) != 1)
+    {
+        ESP_LOGW(TAG_SENS,"Sensor frame seq %u after %u", seq, (uint16_t)*last);
+    }
+    *last = 0x10000u | seq;
+}// eo check_seq::
+
+/*>>> on_sensor_line: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/07/2025
+Modified: 17/10/2026
+Desc: Record handler for the sensor port: apply a delta frame (one slot changed), or decode one
+      full sample, either a binary snapshot or a CSV record from an older transmitter, and apply it.
+Input: net_conn_t *conn - Transmitter connection.
+       const char *line - Binary frame or CSV record.
+       size_t len - Length of line.
+       void *ctx - Unused.
+Return: None
+=========================================================================================================*/
+static void on_sensor_line(net_conn_t *conn, const char *line, size_t len, void *ctx)
+{
+    sensor_frame_t f;
+    sensor_frame_err_t err;
+
+    if ((uint8_t)line[0] == SENSOR_DELTA_SYNC)
+    {
+        sensor_delta_t d;
+        err = sensor_delta_decode((const uint8_t *)line, len, &d);
+        if (err != SENSOR_FRAME_OK || d.slot >= SHELF_SLOTS)
+        {
+            ESP_LOGW(TAG_SENS,"Bad delta frame (error %d), dropped", err);
+            return;
         }
+        check_seq(conn, d.seq);
+        uint16_t bit = 1u << d.slot;
+        apply_occupancy(d.occupied ? (s_occupancy | bit) : (s_occupancy & ~bit));
+        ESP_LOGI(TAG_SENS,"Slot %u %s", d.slot, d.occupied ? "placed" : "picked");
+        return;
+    }
 
-        char buf[64]; 
-        int byterecieve = recv(acceptbar,buf,sizeof(buf)-1,0); // here the 'n' variable is used to store the number of bytes received
-        if (byterecieve>0) 
+    if ((uint8_t)line[0] == SENSOR_FRAME_SYNC)
+    {
+        err = sensor_frame_decode((const uint8_t *)line, len, &f);
+        if (err != SENSOR_FRAME_OK)
         {
-            buf[byterecieve]='\0';
-            while(byterecieve>0&&(buf[byterecieve-1]=='\r'||buf[byterecieve-1]=='\n')) buf[--byterecieve]='\0';
-            ESP_LOGI(TAG,"Received '%s'", buf);
+            ESP_LOGW(TAG_SENS,"Bad sensor frame (error %d), dropped", err);
+            return;
+        }
+        check_seq(conn, f.seq);
+    }
+    else
+    {
+        parse_sensor_csv(line, len, &f);
+    }
 
-            item_info_t info;
-            bool ok = item_sorting_parse(buf,&info);
-            if (!ok && byterecieve==8 && is_digits(buf)) 
-            {
-                info.size  = decode_size (buf[0]);
-                info.type  = decode_type(buf[1]);
-                info.phase = decode_phase(buf[2]);
-                ok = true;
-            }
+    // 1) occupancy
+    apply_occupancy(f.occupancy);
 
-            if (ok) 
-            {
-                // save last
-                strncpy(s_last_code,buf,sizeof(s_last_code));
-                s_last_info = info;  s_has_last = true;
-
-                // decide slot
-                int slot = -1;
-                if (info.type==TYPE_FROZEN) 
-                {
-                    slot = -2;  // Frozen Section
-                }
-                else if (info.phase==PHASE_LIQUID) 
-                {
-                    // always LG_spill at index 9
-                    if (!shelf_manager_is_slot_occupied(LG_SPILL_INDEX)) 
-                    {
-                        slot = LG_SPILL_INDEX;
-                        shelf_manager_mark_occupied(LG_SPILL_INDEX);
-                    }
-                }
-                else 
-                {
-                    slot = shelf_manager_find_slot(&info);
-                    if (slot>=0) shelf_manager_mark_occupied(slot);
-                }
-                s_last_slot = slot;
-
-                // draw
-                lcd20x4_clear(lcd);
-                lcd20x4_set_cursor(lcd,0,0); lcd20x4_write_string(lcd,buf);
-                char line1[21];
-                snprintf(line1, sizeof(line1), "%s/%s/%s", item_sorting_size_string(info.size), item_sorting_type_string(info.type), item_sorting_phase_string(info.phase));
-                lcd20x4_set_cursor(lcd,0,1); 
-                lcd20x4_write_string(lcd,line1);
-
-                char line2[21];
-                if (slot == -2) 
-                {
-                    snprintf(line2, sizeof(line2), "To: Frozen Section");
-                } 
-                else if (slot == LG_SPILL_INDEX) 
-                {
-                    snprintf(line2, sizeof(line2), "To:Liquid_Section");
-                } else if (slot >= 0) 
-                {
-                    snprintf(line2, sizeof(line2), "Slot: %s",
-                            shelf_manager_slot_string(slot));
-                } 
-                else 
-                {
-                    if (info.phase == PHASE_LIQUID) 
-                    {
-                        snprintf(line2, sizeof(line2), "Liquid Section FULL");
-                    } else 
-                    {
-                        snprintf(line2, sizeof(line2), "%s FULL",
-                                item_sorting_size_string(info.size));
-                    }
-                }
-                lcd20x4_set_cursor(lcd, 0, 2);
-                lcd20x4_write_string(lcd, line2);
+    // 2) spill
+    s_spill = f.spill;
+    gpio_set_level(LED_SPILL_GPIO, s_spill);
 
-            }
+    // 3) temp / hum
+    float t = f.temp_c / 100.0f, h = f.hum_c / 100.0f;
+    s_temp = t;  s_hum = h;
+    view_set_env(t, h, s_spill); // redraws only on a visible change
 
-            else 
-            {
-                lcd20x4_clear(lcd);
-                lcd20x4_set_cursor(lcd,0,0); lcd20x4_write_string(lcd,"Invalid barcode");
-            }
-        }
+    // LEDs
+    gpio_set_level(LED_TEMP_GPIO, (t>TEMP_LIMIT));
+    gpio_set_level(LED_HUM_GPIO,  (h> HUM_LIMIT));
 
-        shutdown(acceptbar,0); close(acceptbar);
-        scanning = false;
-        vTaskDelay(pdMS_TO_TICKS(1500));
-        lcd20x4_clear(lcd);
-        lcd20x4_set_cursor(lcd,0,0); lcd20x4_write_string(lcd,"Barcode Sorting");
-        lcd20x4_set_cursor(lcd,0,1); lcd20x4_write_string(lcd,"Waiting for scan:");
-    }
-}// eo scan_task::
+    ESP_LOGI(TAG_SENS,"Updated occ + spill=%d + T=%.1f°C H=%.1f%%", s_spill, t, h);
+}// eo on_sensor_line::
 
-// ─── Sensor Task ──────────────────────────────────────────────────────────────
-/*>>> sensor_task: ======================================================================
+// ─── Buttons ──────────────────────────────────────────────────────────────────
+/*>>> ui_task: ======================================================================
 Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
 Date: 17/07/2025
-Modified: 27/07/2025
-Desc: Task to handle sensor data processing.
-Input: void *arg - Pointer to the LCD driver.
+Modified: 17/10/2026
+Desc: Act on debounced button events as they arrive (formerly polled by the reactor tick). SW1
+      toggles scan mode on press; SW2 re-displays the last scan on press and shows the scan
+      pipeline counters on a long press.
+Input: void *arg - Unused.
 Return: None
 =========================================================================================================*/
-static void sensor_task(void *arg) 
+static void ui_task(void *arg)
 {
     (void)arg;
-    struct sockaddr_in addr = {
-        .sin_family      = AF_INET,
-        .sin_port        = htons(SENS_PORT),
-        .sin_addr.s_addr = htonl(INADDR_ANY),
-    };
-
-    int ls = socket(AF_INET, SOCK_STREAM, IPPROTO_IP); // here the 'ls' variable is used to store the socket file descriptor
-    setsockopt(ls, SOL_SOCKET, SO_REUSEADDR, &(int){1}, sizeof(int));
-    bind(ls, (struct sockaddr*)&addr, sizeof(addr));
-    listen(ls, 1);
-    ESP_LOGI(TAG_SENS, "Listening on port %d", SENS_PORT);
-
-    for (;;) 
+    button_event_t ev;
+    for (;;)
     {
-        int c = accept(ls, NULL, NULL); // here the 'c' variable is used to store the client socket file descriptor
-        if (c<0) 
-        { 
-            vTaskDelay(pdMS_TO_TICKS(100)); continue; 
+        if (!buttons_wait(&ev, UINT32_MAX))
+        {
+            continue;
         }
-
-        char buf[128];
-        int len = recv(c, buf, sizeof(buf)-1, 0);
-        if (len>0) 
+        if (ev.button == BTN_SW1 && ev.type == BUTTON_PRESS)
         {
-            buf[len]='\0';
-
-            // 1) occupancy
-            bool ir[SHELF_SLOTS];
-            char *tok = strtok(buf, ",");
-            for (int i=0;i<SHELF_SLOTS && tok;++i) 
+            s_scanning = !s_scanning;
+            ESP_LOGI(TAG,"SW1 → scanning=%d", s_scanning);
+            if (s_scanning) 
             {
-                ir[i] = (tok[0]=='1');
-                tok   = strtok(NULL,",");
-            }
-            shelf_manager_update_from_sensors(ir);
-
-            // 2) spill
-            if (tok) 
+                view_set_page(VIEW_PAGE_SCAN);
+            } else 
             {
-                s_spill = (tok[0]=='1');
-                gpio_set_level(LED_SPILL_GPIO, s_spill);
-                tok = strtok(NULL,",");
+                view_set_page(VIEW_PAGE_HOME);
+                view_toast_text("Aborted scan", TOAST_ABORT_MS);
             }
-
-            // 3) temp
-            float t=0,h=0;
-            if (tok) 
+        }
+        else if (ev.button == BTN_SW2 && ev.type == BUTTON_PRESS)
+        {
+            esp_err_t err = scan_pipeline_show_last();
+            if (err == ESP_ERR_NOT_FOUND)
             {
-                t = strtof(tok, &tok);
+                view_toast_text("No scan yet", TOAST_ABORT_MS);
             }
-            // 4) hum
-            if (tok) 
+            else if (err != ESP_OK)
             {
-                h = strtof(tok+1, NULL);
+                ESP_LOGW(TAG, "SW2: render stage busy, last scan not shown");
             }
-            s_temp = t;  s_hum = h;
-
-            // LEDs
-            gpio_set_level(LED_TEMP_GPIO, (t>TEMP_LIMIT));
-            gpio_set_level(LED_HUM_GPIO,  (h> HUM_LIMIT));
-
-            ESP_LOGI(TAG_SENS,"Updated occ + spill=%d + T=%.1f°C H=%.1f%%", s_spill, t, h);
         }
-        shutdown(c,0); close(c);
+        else if (ev.button == BTN_SW2 && ev.type == BUTTON_LONG_PRESS)
+        {
+            scan_pipeline_stats_t st;
+            scan_pipeline_get_stats(&st);
+            lcd20x4_frame_t frame;
+            lcd20x4_frame_clear(&frame);
+            lcd20x4_frame_write(&frame, 0, 0, "Scan pipeline");
+            lcd20x4_frame_printf(&frame, 0, 1, "In:%lu Done:%lu",
+                    (unsigned long)st.ingested, (unsigned long)st.allocated);
+            lcd20x4_frame_printf(&frame, 0, 2, "Busy:%lu Skip:%lu",
+                    (unsigned long)st.alloc_drops, (unsigned long)st.render_drops);
+            lcd20x4_frame_printf(&frame, 0, 3, "Peak q:%lu/%lu",
+                    (unsigned long)st.alloc_hwm, (unsigned long)st.render_hwm);
+            view_toast(&frame, TOAST_STATS_MS);
+        }
     }
-}// eo sensor_task::
+}// eo ui_task::
+
+// ─── Network Task ─────────────────────────────────────────────────────────────
+/*>>> net_task: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: 17/10/2026
+Desc: Single task serving the scan and sensor ports. Scanner stations keep sessions open and send
+      newline-terminated barcodes; transmitters send binary snapshot/delta frames (or CSV). Every
+      client of both ports is multiplexed by the reactor.
+Input: void *arg - Unused.
+Return: None
+=========================================================================================================*/
+static void net_task(void *arg)
+{
+    (void)arg;
+    ESP_ERROR_CHECK(net_reactor_listen(TCP_PORT,  SCAN_IDLE_MS, on_scan_line,   NULL));
+    ESP_ERROR_CHECK(net_reactor_listen(SENS_PORT, SENS_IDLE_MS, on_sensor_line, NULL));
+    ESP_ERROR_CHECK(net_reactor_accept_binary(SENS_PORT, SENSOR_FRAME_SYNC, SENSOR_FRAME_LEN));
+    ESP_ERROR_CHECK(net_reactor_accept_binary(SENS_PORT, SENSOR_DELTA_SYNC, SENSOR_DELTA_LEN));
+    net_reactor_run(NET_TICK_MS, NULL, NULL);
+}// eo net_task::
 
 /*>>> app_main: ====================================================================== */
 
@@ -449,7 +421,8 @@ void app_main(void)
     wifi_init_softap();
     static lcd_20x4_driver_t lcd;
     peripherals_init(&lcd);
+    ESP_ERROR_CHECK(scan_pipeline_start());
 
-    xTaskCreate(scan_task,   "scan",   4096, &lcd,  5, NULL);
-    xTaskCreate(sensor_task, "sensor", 4096, NULL, 5, NULL);
+    xTaskCreate(net_task, "net", 4096, NULL, 5, NULL);
+    xTaskCreate(ui_task,  "ui",  3072, NULL, 5, NULL);
 }// eo app_main::
@@ -0,0 +1,410 @@
+/*======================================================================================================
+File Name:	net_reactor.c
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the implementation of the network reactor. All sockets are
+non-blocking; a single select() waits on the listeners and every client, each client has its
+own line framer as receive buffer, and clients that stay silent longer than their port's idle
+timeout are closed so a dead peer cannot hold a socket forever.
+====================================================================================================*/
+
+#include "net_reactor.h"
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "lwip/sockets.h"
+
+static const char *TAG = "NET_REACTOR";
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // lwIP never raises SIGPIPE; POSIX hosts (linux target) would
+#endif
+
+typedef struct {
+    int           fd;               // listening socket, -1 if unused
+    uint16_t      port;
+    TickType_t    idle_timeout;     // 0 = never
+    net_line_cb_t on_line;
+    void         *ctx;
+    line_framer_t framing;          // binary record types only (copied into each client's framer)
+} net_listener_t; // One listening port
+
+struct net_conn {
+    int            fd;              // client socket, -1 if the slot is free
+    uint16_t       gen;             // bumped on every accept into this slot
+    net_listener_t *owner;          // port it was accepted on
+    TickType_t     last_rx;         // tick of the last received data
+    line_framer_t  framer;          // per-connection receive buffer
+    uint32_t       user;            // record handler's per-connection state, 0 on accept
+}; // One accepted client
+
+static net_listener_t      s_listeners[NET_MAX_LISTENERS] = {
+    [0 ... NET_MAX_LISTENERS - 1] = { .fd = -1 },
+};
+static net_conn_t          s_conns[NET_MAX_CONNS] = {
+    [0 ... NET_MAX_CONNS - 1] = { .fd = -1 },
+};
+static net_reactor_stats_t s_stats;
+static SemaphoreHandle_t   s_lock;   // guards fd/gen of s_conns against senders in other tasks
+
+/*>>> set_nonblocking: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Put a socket in non-blocking mode.
+Input: int fd - Socket.
+Return: None
+=========================================================================================================*/
+static void set_nonblocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+} // eo set_nonblocking::
+
+/*>>> net_reactor_listen: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Open a non-blocking listening socket and register its record handler.
+Input: uint16_t port - TCP port.
+       uint32_t idle_timeout_ms - Idle limit for clients of this port (0 = none).
+       net_line_cb_t on_line - Record handler.
+       void *ctx - Passed to on_line.
+Return: esp_err_t - ESP_OK, ESP_ERR_NO_MEM or ESP_FAIL.
+=========================================================================================================*/
+esp_err_t net_reactor_listen(uint16_t port, uint32_t idle_timeout_ms, net_line_cb_t on_line, void *ctx)
+{
+    net_listener_t *l = NULL;
+    for (int i = 0; i < NET_MAX_LISTENERS && !l; i++)
+    {
+        if (s_listeners[i].fd < 0) l = &s_listeners[i];
+    }
+    if (!l) return ESP_ERR_NO_MEM;
+    if (!s_lock && !(s_lock = xSemaphoreCreateMutex())) return ESP_ERR_NO_MEM;
+
+    struct sockaddr_in addr = {
+        .sin_family      = AF_INET,
+        .sin_port        = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    int fd = socket(AF_INET, SOCK_STREAM, IPPROTO_IP);
+    if (fd < 0) return ESP_FAIL;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &(int){1}, sizeof(int));
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, NET_LISTEN_BACKLOG) != 0)
+    {
+        ESP_LOGE(TAG, "port %u: bind/listen errno %d", port, errno);
+        close(fd);
+        return ESP_FAIL;
+    }
+    set_nonblocking(fd);
+
+    l->fd           = fd;
+    l->port         = port;
+    l->idle_timeout = pdMS_TO_TICKS(idle_timeout_ms);
+    l->on_line      = on_line;
+    l->ctx          = ctx;
+    ESP_LOGI(TAG, "Listening on port %u", port);
+    return ESP_OK;
+} // eo net_reactor_listen::
+
+/*>>> net_reactor_accept_binary: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Let clients of a port also send fixed-length binary records (applies to new connections). May
+      be called once per record type, up to LINE_FRAMER_BIN_KINDS.
+Input: uint16_t port - Port given to net_reactor_listen().
+       uint8_t sync - First byte of every record of this type.
+       size_t len - Record length.
+Return: esp_err_t - ESP_OK, ESP_ERR_INVALID_ARG if len is out of range or too many types are
+        registered, or ESP_ERR_NOT_FOUND.
+=========================================================================================================*/
+esp_err_t net_reactor_accept_binary(uint16_t port, uint8_t sync, size_t len)
+{
+    for (int i = 0; i < NET_MAX_LISTENERS; i++)
+    {
+        net_listener_t *l = &s_listeners[i];
+        if (l->fd >= 0 && l->port == port)
+        {
+            return line_framer_set_binary(&l->framing, sync, len) ? ESP_OK : ESP_ERR_INVALID_ARG;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+} // eo net_reactor_accept_binary::
+
+/*>>> conn_accept: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: 17/10/2026
+Desc: Accept a pending client into a free slot, or close it at once if the pool is full.
+Input: net_listener_t *l - Listener that is readable.
+Return: None
+=========================================================================================================*/
+static void conn_accept(net_listener_t *l)
+{
+    int fd = accept(l->fd, NULL, NULL);
+    if (fd < 0) return;
+
+    for (int i = 0; i < NET_MAX_CONNS; i++)
+    {
+        net_conn_t *c = &s_conns[i];
+        if (c->fd >= 0) continue;
+        set_nonblocking(fd);
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        c->fd      = fd;
+        c->gen++;
+        xSemaphoreGive(s_lock);
+        c->owner   = l;
+        c->last_rx = xTaskGetTickCount();
+        c->user    = 0;
+        c->framer = l->framing;
+        line_framer_reset(&c->framer);
+        s_stats.accepted++;
+        ESP_LOGI(TAG, "port %u: client %d connected", l->port, fd);
+        return;
+    }
+    s_stats.rejected++;
+    ESP_LOGW(TAG, "port %u: no free connection slot, rejecting", l->port);
+    close(fd);
+} // eo conn_accept::
+
+/*>>> net_conn_close: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Close a client connection and free its slot.
+Input: net_conn_t *conn - Connection.
+Return: None
+=========================================================================================================*/
+void net_conn_close(net_conn_t *conn)
+{
+    if (conn->fd < 0) return;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    shutdown(conn->fd, 0);
+    close(conn->fd);
+    conn->fd = -1;
+    xSemaphoreGive(s_lock);
+} // eo net_conn_close::
+
+/*>>> conn_send_locked: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Send on a client socket without blocking. Caller holds s_lock.
+Input: net_conn_t *conn - Connection.
+       const void *data - Bytes to send.
+       size_t len - Number of bytes.
+Return: int - Bytes sent, or -1 on error.
+=========================================================================================================*/
+static int conn_send_locked(net_conn_t *conn, const void *data, size_t len)
+{
+    if (conn->fd < 0) return -1;
+    int n = send(conn->fd, data, len, MSG_NOSIGNAL);
+    if (n != (int)len)
+    {
+        ESP_LOGW(TAG, "client %d: short send %d/%u (errno %d)", conn->fd, n, (unsigned)len, errno);
+    }
+    return n;
+} // eo conn_send_locked::
+
+/*>>> net_conn_send: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: 17/10/2026
+Desc: Send on a client connection without blocking the reactor.
+Input: net_conn_t *conn - Connection.
+       const void *data - Bytes to send.
+       size_t len - Number of bytes.
+Return: int - Bytes sent, or -1 on error.
+=========================================================================================================*/
+int net_conn_send(net_conn_t *conn, const void *data, size_t len)
+{
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    int n = conn_send_locked(conn, data, len);
+    xSemaphoreGive(s_lock);
+    return n;
+} // eo net_conn_send::
+
+/*>>> net_conn_id: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Name a connection in a way that stays safe to use after it has been closed.
+Input: const net_conn_t *conn - Connection.
+Return: net_conn_id_t - Slot + generation (never NET_CONN_ID_NONE).
+=========================================================================================================*/
+net_conn_id_t net_conn_id(const net_conn_t *conn)
+{
+    return ((net_conn_id_t)conn->gen << 8) | (net_conn_id_t)(conn - s_conns + 1);
+} // eo net_conn_id::
+
+/*>>> net_conn_user: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Give the record handler a word of state that belongs to this connection only.
+Input: net_conn_t *conn - Connection.
+Return: uint32_t * - The connection's user word (zeroed when the client is accepted).
+=========================================================================================================*/
+uint32_t *net_conn_user(net_conn_t *conn)
+{
+    return &conn->user;
+} // eo net_conn_user::
+
+/*>>> net_reactor_send: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Send to a connection from any task. If it has been closed (or its slot reused by a newer
+      client) in the meantime, nothing is sent.
+Input: net_conn_id_t id - From net_conn_id().
+       const void *data - Bytes to send.
+       size_t len - Number of bytes.
+Return: int - Bytes sent, or -1 if the connection is gone or the send failed.
+=========================================================================================================*/
+int net_reactor_send(net_conn_id_t id, const void *data, size_t len)
+{
+    unsigned slot = (id & 0xFF) - 1;
+    if (slot >= NET_MAX_CONNS) return -1;
+    net_conn_t *c = &s_conns[slot];
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    int n = (c->gen == (uint16_t)(id >> 8)) ? conn_send_locked(c, data, len) : -1;
+    xSemaphoreGive(s_lock);
+    return n;
+} // eo net_reactor_send::
+
+/*>>> conn_on_line: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Line framer callback: pass a record on to the handler of the connection's port.
+Input: const char *line - Record.
+       size_t len - Length of line.
+       void *ctx - Connection.
+Return: None
+=========================================================================================================*/
+static void conn_on_line(const char *line, size_t len, void *ctx)
+{
+    net_conn_t *c = ctx;
+    s_stats.records++;
+    c->owner->on_line(c, line, len, c->owner->ctx);
+} // eo conn_on_line::
+
+/*>>> conn_read: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Read what a readable client has sent and deliver complete records; close it on EOF/error.
+Input: net_conn_t *c - Readable connection.
+Return: None
+=========================================================================================================*/
+static void conn_read(net_conn_t *c)
+{
+    char buf[NET_RX_CHUNK];
+    int n = recv(c->fd, buf, sizeof(buf), 0);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+
+    unsigned dropped = c->framer.dropped;
+    if (n > 0)
+    {
+        c->last_rx = xTaskGetTickCount();
+        line_framer_feed(&c->framer, buf, n, conn_on_line, c);
+    }
+    else
+    {
+        line_framer_flush(&c->framer, conn_on_line, c); // peer may not end its last record with '\n'
+        ESP_LOGI(TAG, "port %u: client %d closed", c->owner->port, c->fd);
+        net_conn_close(c);
+    }
+    s_stats.dropped += c->framer.dropped - dropped;
+} // eo conn_read::
+
+/*>>> net_reactor_run: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Event loop: wait on every socket with select(), accept, read, expire idle clients and run the
+      periodic callback.
+Input: uint32_t tick_ms - Longest select() wait.
+       net_tick_cb_t on_tick - Periodic callback (may be NULL).
+       void *ctx - Passed to on_tick.
+Return: None
+=========================================================================================================*/
+void net_reactor_run(uint32_t tick_ms, net_tick_cb_t on_tick, void *ctx)
+{
+    for (;;)
+    {
+        fd_set rd;
+        FD_ZERO(&rd);
+        int maxfd = -1;
+        for (int i = 0; i < NET_MAX_LISTENERS; i++)
+        {
+            int fd = s_listeners[i].fd;
+            if (fd < 0) continue;
+            FD_SET(fd, &rd);
+            if (fd > maxfd) maxfd = fd;
+        }
+        for (int i = 0; i < NET_MAX_CONNS; i++)
+        {
+            int fd = s_conns[i].fd;
+            if (fd < 0) continue;
+            FD_SET(fd, &rd);
+            if (fd > maxfd) maxfd = fd;
+        }
+
+        struct timeval tv = { .tv_sec = tick_ms / 1000, .tv_usec = (tick_ms % 1000) * 1000 };
+        int ready = select(maxfd + 1, &rd, NULL, NULL, &tv);
+        if (ready < 0)
+        {
+            ESP_LOGE(TAG, "select errno %d", errno);
+            vTaskDelay(pdMS_TO_TICKS(tick_ms));
+        }
+        else if (ready > 0)
+        {
+            for (int i = 0; i < NET_MAX_CONNS; i++)
+            {
+                if (s_conns[i].fd >= 0 && FD_ISSET(s_conns[i].fd, &rd)) conn_read(&s_conns[i]);
+            }
+            for (int i = 0; i < NET_MAX_LISTENERS; i++)
+            {
+                if (s_listeners[i].fd >= 0 && FD_ISSET(s_listeners[i].fd, &rd)) conn_accept(&s_listeners[i]);
+            }
+        }
+
+        // expire idle clients
+        TickType_t now = xTaskGetTickCount();
+        for (int i = 0; i < NET_MAX_CONNS; i++)
+        {
+            net_conn_t *c = &s_conns[i];
+            if (c->fd < 0 || !c->owner->idle_timeout) continue;
+            if (now - c->last_rx >= c->owner->idle_timeout)
+            {
+                ESP_LOGW(TAG, "port %u: client %d idle, closing", c->owner->port, c->fd);
+                s_stats.timed_out++;
+                net_conn_close(c);
+            }
+        }
+
+        if (on_tick) on_tick(ctx);
+    }
+} // eo net_reactor_run::
+
+/*>>> net_reactor_get_stats: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Copy out the reactor counters.
+Input: net_reactor_stats_t *out - Destination.
+Return: None
+=========================================================================================================*/
+void net_reactor_get_stats(net_reactor_stats_t *out)
+{
+    *out = s_stats;
+} // eo net_reactor_get_stats::
@@ -0,0 +1,92 @@
+/*======================================================================================================
+File Name:	net_reactor.h
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the interface for the network reactor: one task that multiplexes
+every listening socket and every accepted client with select(), so any number of scanners and
+transmitters (up to NET_MAX_CONNS) are served without a task per connection.
+====================================================================================================*/
+
+#ifndef NET_REACTOR_H
+#define NET_REACTOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "line_framer.h"
+
+#define NET_MAX_LISTENERS   2   // Listening ports
+#define NET_MAX_CONNS       6   // Accepted clients (lwIP allows 10 sockets in total)
+#define NET_LISTEN_BACKLOG  4   // Pending connections per port
+#define NET_RX_CHUNK        128 // Bytes read per recv()
+
+typedef struct net_conn net_conn_t;
+typedef uint32_t net_conn_id_t;  // connection handle that is safe to keep across tasks
+#define NET_CONN_ID_NONE 0
+
+/// Called in the reactor task for each newline-terminated record from a client
+/// (or each binary record, see net_reactor_accept_binary()).
+typedef void (*net_line_cb_t)(net_conn_t *conn, const char *line, size_t len, void *ctx);
+
+/// Called in the reactor task at least every `tick_ms` (see net_reactor_run()).
+typedef void (*net_tick_cb_t)(void *ctx);
+
+typedef struct {
+    uint32_t accepted;   // connections accepted
+    uint32_t rejected;   // connections closed at once because the pool was full
+    uint32_t timed_out;  // connections closed for being idle
+    uint32_t records;    // records delivered
+    uint32_t dropped;    // records dropped for being too long
+} net_reactor_stats_t; // Reactor counters
+
+/**
+ * @brief Listen on a TCP port. Must be called before net_reactor_run().
+ * @param port             TCP port
+ * @param idle_timeout_ms  Close a client after this long without data (0 = never)
+ * @param on_line          Record handler for clients of this port
+ * @param ctx              Passed to on_line
+ * @return ESP_OK, ESP_ERR_NO_MEM if NET_MAX_LISTENERS are in use, or ESP_FAIL
+ *         if the socket could not be set up.
+ */
+esp_err_t net_reactor_listen(uint16_t port, uint32_t idle_timeout_ms, net_line_cb_t on_line, void *ctx);
+
+/**
+ * @brief Let clients of `port` send fixed-length binary records starting
+ *        with `sync` alongside text records; both reach the port's handler.
+ *        Call once per record type (up to LINE_FRAMER_BIN_KINDS).
+ */
+esp_err_t net_reactor_accept_binary(uint16_t port, uint8_t sync, size_t len);
+
+/**
+ * @brief Run the reactor in the calling task; never returns.
+ * @param tick_ms  Longest time select() may block before on_tick runs
+ * @param on_tick  Optional periodic work (e.g. polling buttons)
+ * @param ctx      Passed to on_tick
+ */
+void net_reactor_run(uint32_t tick_ms, net_tick_cb_t on_tick, void *ctx);
+
+/// Send on a client connection; short writes are not retried.
+int  net_conn_send(net_conn_t *conn, const void *data, size_t len);
+
+/// Handle for replying to `conn` later, e.g. from another task.
+net_conn_id_t net_conn_id(const net_conn_t *conn);
+
+/// Per-connection state for the record handler (reactor task only); 0 for a new client.
+uint32_t *net_conn_user(net_conn_t *conn);
+
+/**
+ * @brief Send to a connection from any task. Does nothing (returns -1) if
+ *        the connection has been closed since its ID was taken, even if the
+ *        slot now holds another client.
+ */
+int  net_reactor_send(net_conn_id_t id, const void *data, size_t len);
+
+/// Close a client connection (safe from inside its record handler).
+void net_conn_close(net_conn_t *conn);
+
+void net_reactor_get_stats(net_reactor_stats_t *out);
+
+#endif // NET_REACTOR_H
@@ -0,0 +1,507 @@
+/*======================================================================================================
+File Name:	scan_pipeline.c
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the implementation of the staged scan pipeline. The network reactor
+only queues barcodes; the allocate task owns slot allocation and acknowledges each barcode to its
+scanner; the render task turns results into toasts. Every hand-off is a bounded queue that never
+blocks the stage in front of it: a full allocate queue answers the scanner BUSY, a full render
+queue drops its oldest result in favour of the newest. IDLE and BUSY answers are queued as reject
+records behind the barcodes already waiting, so every ack leaves in arrival order.
+====================================================================================================*/
+
+#include "scan_pipeline.h"
+#include <string.h>
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "lcd_20x4_driver.h"
+#include "view_manager.h"
+
+static const char *TAG = "SCAN_PIPELINE";
+
+#define TOAST_RESULT_MS 1500 // scan result / invalid barcode
+
+// Your LG_spill slot lives at index 9 (0–9 total slots)
+#define LG_SPILL_INDEX 9 // Large liquid spill slot
+
+#define SCAN_ACK_MAX   (3 * LINE_FRAMER_MAX + 48) // "ACK <status> <barcode> <slot> <reason>\n", barcode escaped
+
+typedef struct {
+    net_conn_id_t conn;                       // scanner to acknowledge
+    char          code[LINE_FRAMER_MAX + 1];  // barcode
+    uint8_t       len;
+    bool          reject;                     // only acknowledge with `status`
+    scan_status_t status;                     // IDLE / BUSY for a reject
+} scan_job_t; // Allocate stage input
+
+static QueueHandle_t          s_alloc_q;    // ingest → allocate
+static QueueHandle_t          s_render_q;   // allocate → render
+static SemaphoreHandle_t      s_lock;       // guards shelf_manager and s_last
+static scan_record_t          s_last;       // last decoded scan
+static bool                   s_has_last;
+static scan_pipeline_stats_t  s_stats;
+static uint32_t               s_jobs_queued;  // barcodes queued for allocation (ingest only)
+static volatile uint32_t      s_jobs_taken;   // of which taken by the allocate stage (alloc only)
+
+// ─── Helpers ─────────────────────────────────────────────────────────────────
+/*>>> is_digits: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/07/2025
+Modified: 27/07/2025
+Desc: Check if a string consists only of digits.
+Input: const char *s - The input string to check.
+Return: bool - True if the string is all digits, false otherwise.
+=========================================================================================================*/
+static bool is_digits(const char *s) 
+{
+    for (; *s; ++s) if (*s < '0' || *s > '9') return false;
+    return true;
+} // eo is_digits::
+
+/*>>> decode_size: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/07/2025
+Modified: 29/07/2025
+Desc: Decode a character into an item size.
+Input: char d - The character to decode.
+Return: item_size_t - The decoded item size.
+=========================================================================================================*/
+static item_size_t  decode_size(char d)  
+{
+    if      (d >= '0' && d <= '2') return SIZE_SMALL;
+    else if (d >= '3' && d <= '6') return SIZE_MEDIUM;
+    else                            return SIZE_LARGE;
+} // eo decode_size::
+
+/*>>> decode_type: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/07/2025
+Modified: 29/07/2025
+Desc: Decode a character into an item type.
+Input: char d - The character to decode.
+Return: item_type_t - The decoded item type.
+=========================================================================================================*/
+static item_type_t  decode_type(char d)  
+{
+    return (d=='0') ? TYPE_FROZEN : TYPE_DRY;
+} // eo decode_type::
+
+/*>>> decode_phase: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/07/2025
+Modified: 29/07/2025
+Desc: Decode a character into an item phase.
+Input: char d - The character to decode.
+Return: item_phase_t - The decoded item phase.
+=========================================================================================================*/
+static item_phase_t decode_phase(char d) 
+{
+    return (d <= '5') ? PHASE_LIQUID : PHASE_SOLID;
+} // eo decode_phase::
+
+/*>>> escape_field: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Copy a string into a single ack field: spaces, control characters and '%' are written as
+      %XX (URL percent-encoding), so the field never splits the line. An empty string becomes "-".
+Input: const char *in - String to escape.
+       char *out - Destination, at least 3 * strlen(in) + 2 bytes.
+Return: None
+=========================================================================================================*/
+static void escape_field(const char *in, char *out)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    if (!*in)
+    {
+        strcpy(out, "-");
+        return;
+    }
+    for (; *in; in++)
+    {
+        uint8_t c = (uint8_t)*in;
+        if (c <= ' ' || c == '%' || c == 0x7F)
+        {
+            *out++ = '%';
+            *out++ = hex[c >> 4];
+            *out++ = hex[c & 0x0F];
+        }
+        else
+        {
+            *out++ = (char)c;
+        }
+    }
+    *out = '\0';
+}// eo escape_field::
+
+/*>>> send_scan_ack: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: 17/10/2026
+Desc: Answer a barcode on the connection it came from with one line:
+          ACK <status> <barcode> <slot> <reason>
+      status is OK, FULL, INVALID, IDLE (scan mode off) or BUSY (pipeline full); slot is the shelf slot name or
+      FROZEN_SECTION; reason says which zone is full. Absent fields are "-". The barcode is
+      percent-encoded (see escape_field), so the line always has five fields. Acks are sent in
+      the order the barcodes arrived (IDLE / BUSY included, see scan_pipeline_ingest), so a
+      station may pipeline scans and match replies in order.
+Input: net_conn_id_t conn - Scanner connection.
+       const char *code - Barcode being answered.
+       const scan_result_t *res - Outcome.
+Return: None
+=========================================================================================================*/
+static void send_scan_ack(net_conn_id_t conn, const char *code, const scan_result_t *res)
+{
+    static const char *const status_names[] = {
+        [SCAN_OK] = "OK", [SCAN_FULL] = "FULL", [SCAN_INVALID] = "INVALID", [SCAN_IDLE] = "IDLE",
+        [SCAN_BUSY] = "BUSY",
+    };
+    const char *slot   = "-";
+    char        reason[24] = "-";
+    if (res->status == SCAN_OK)
+    {
+        slot = (res->slot == -2) ? "FROZEN_SECTION" : shelf_manager_slot_string(res->slot);
+    }
+    else if (res->status == SCAN_FULL)
+    {
+        snprintf(reason, sizeof(reason), "%s_FULL", (res->info.phase == PHASE_LIQUID)
+                 ? "LIQUID_SECTION" : item_sorting_size_string(res->info.size));
+    }
+
+    char field[3 * LINE_FRAMER_MAX + 2];
+    escape_field(code, field);
+
+    char ack[SCAN_ACK_MAX];
+    int n = snprintf(ack, sizeof(ack), "ACK %s %s %s %s\n", status_names[res->status], field, slot, reason);
+    if (n > 0) net_reactor_send(conn, ack, (n < (int)sizeof(ack)) ? (size_t)n : sizeof(ack) - 1);
+}// eo send_scan_ack::
+
+// ─── Allocate Stage ──────────────────────────────────────────────────────────
+/*>>> allocate_scan: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/07/2025
+Modified: 17/10/2026
+Desc: Allocate stage work for one barcode: decode it and pick its slot. Drawing the result is
+      left to the render stage.
+Input: const char *code - Barcode, without line terminator.
+       size_t len - Length of code.
+       scan_result_t *res - Receives the outcome (reported back to the scanner).
+Return: None
+=========================================================================================================*/
+static void allocate_scan(const char *code, size_t len, scan_result_t *res)
+{
+    ESP_LOGI(TAG,"Received '%s'", code);
+
+    item_info_t info;
+    bool ok = item_sorting_parse(code,&info);
+    if (!ok && len==8 && is_digits(code)) 
+    {
+        info.size  = decode_size (code[0]);
+        info.type  = decode_type(code[1]);
+        info.phase = decode_phase(code[2]);
+        ok = true;
+    }
+
+    if (ok) 
+    {
+        // decide slot
+        int slot = -1;
+        if (info.type==TYPE_FROZEN) 
+        {
+            slot = -2;  // Frozen Section
+        }
+        else if (info.phase==PHASE_LIQUID) 
+        {
+            // always LG_spill at index 9
+            if (!shelf_manager_is_slot_occupied(LG_SPILL_INDEX)) 
+            {
+                slot = LG_SPILL_INDEX;
+                shelf_manager_mark_occupied(LG_SPILL_INDEX);
+            }
+        }
+        else 
+        {
+            slot = shelf_manager_find_slot(&info);
+            if (slot>=0) shelf_manager_mark_occupied(slot);
+        }
+        res->info   = info;
+        res->slot   = slot;
+        res->status = (slot == -1) ? SCAN_FULL : SCAN_OK;
+    }
+    else 
+    {
+        res->status = SCAN_INVALID;
+        res->slot   = -1;
+    }
+}// eo allocate_scan::
+
+/*>>> alloc_task: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: 17/10/2026
+Desc: Allocate stage: decode and place each queued barcode, acknowledge it, and pass the result on
+      to the render stage (dropping the oldest waiting result if that stage is behind). Reject
+      records are only acknowledged.
+Input: void *arg - Unused.
+Return: None
+=========================================================================================================*/
+static void alloc_task(void *arg)
+{
+    (void)arg;
+    scan_job_t    job;
+    scan_record_t rec;
+    for (;;)
+    {
+        xQueueReceive(s_alloc_q, &job, portMAX_DELAY);
+
+        memcpy(rec.code, job.code, job.len + 1);
+        if (job.reject)
+        {
+            rec.res = (scan_result_t){ .status = job.status, .slot = -1 };
+            send_scan_ack(job.conn, rec.code, &rec.res);
+            continue;
+        }
+        s_jobs_taken++;
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        allocate_scan(rec.code, job.len, &rec.res);
+        if (rec.res.status != SCAN_INVALID)
+        {
+            s_last     = rec;
+            s_has_last = true;
+        }
+        xSemaphoreGive(s_lock);
+        s_stats.allocated++;
+
+        send_scan_ack(job.conn, rec.code, &rec.res);
+
+        if (xQueueSend(s_render_q, &rec, 0) != pdTRUE)
+        {
+            scan_record_t stale;
+            xQueueReceive(s_render_q, &stale, 0); // newest result wins the display
+            xQueueSend(s_render_q, &rec, 0);
+            s_stats.render_drops++;
+        }
+        UBaseType_t depth = uxQueueMessagesWaiting(s_render_q);
+        if (depth > s_stats.render_hwm) s_stats.render_hwm = depth;
+    }
+}// eo alloc_task::
+
+// ─── Render Stage ────────────────────────────────────────────────────────────
+/*>>> render_scan: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/07/2025
+Modified: 17/10/2026
+Desc: Render stage work for one result: compose it as a toast (formerly the drawing half of
+      scan_task).
+Input: const scan_record_t *rec - Barcode and its result.
+Return: None
+=========================================================================================================*/
+static void render_scan(const scan_record_t *rec)
+{
+    if (rec->res.status == SCAN_INVALID)
+    {
+        view_toast_text("Invalid barcode", TOAST_RESULT_MS);
+        return;
+    }
+
+    lcd20x4_frame_t frame;
+    lcd20x4_frame_clear(&frame);
+    lcd20x4_frame_write(&frame,0,0,rec->code);
+    lcd20x4_frame_printf(&frame, 0, 1, "%s/%s/%s", item_sorting_size_string(rec->res.info.size), item_sorting_type_string(rec->res.info.type), item_sorting_phase_string(rec->res.info.phase));
+
+    if (rec->res.slot == -2) 
+    {
+        lcd20x4_frame_write(&frame, 0, 2, "To: Frozen Section");
+    } 
+    else if (rec->res.slot == LG_SPILL_INDEX) 
+    {
+        lcd20x4_frame_write(&frame, 0, 2, "To:Liquid_Section");
+    } else if (rec->res.slot >= 0) 
+    {
+        lcd20x4_frame_printf(&frame, 0, 2, "Slot: %s",
+                shelf_manager_slot_string(rec->res.slot));
+    } 
+    else 
+    {
+        if (rec->res.info.phase == PHASE_LIQUID) 
+        {
+            lcd20x4_frame_write(&frame, 0, 2, "Liquid Section FULL");
+        } else 
+        {
+            lcd20x4_frame_printf(&frame, 0, 2, "%s FULL",
+                    item_sorting_size_string(rec->res.info.size));
+        }
+    }
+    view_toast(&frame, TOAST_RESULT_MS);
+}// eo render_scan::
+
+/*>>> render_task: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Render stage: draw each result as it arrives. Toasts never block, so this stage keeps up
+      with allocation; the hold time only decides how long the newest result stays visible.
+Input: void *arg - Unused.
+Return: None
+=========================================================================================================*/
+static void render_task(void *arg)
+{
+    (void)arg;
+    scan_record_t rec;
+    for (;;)
+    {
+        xQueueReceive(s_render_q, &rec, portMAX_DELAY);
+        render_scan(&rec);
+    }
+}// eo render_task::
+
+// ─── Public API ──────────────────────────────────────────────────────────────
+/*>>> scan_pipeline_start: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Create the stage queues and tasks.
+Input: None
+Return: esp_err_t - ESP_OK, or ESP_ERR_NO_MEM.
+=========================================================================================================*/
+esp_err_t scan_pipeline_start(void)
+{
+    s_alloc_q  = xQueueCreate(SCAN_ALLOC_QUEUE_LEN + SCAN_REJECT_RESERVE, sizeof(scan_job_t));
+    s_render_q = xQueueCreate(SCAN_RENDER_QUEUE_LEN, sizeof(scan_record_t));
+    s_lock     = xSemaphoreCreateMutex();
+    if (!s_alloc_q || !s_render_q || !s_lock)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    if (xTaskCreate(alloc_task,  "scan_alloc",  SCAN_STAGE_STACK, NULL, SCAN_ALLOC_PRIORITY,  NULL) != pdPASS ||
+        xTaskCreate(render_task, "scan_render", SCAN_STAGE_STACK, NULL, SCAN_RENDER_PRIORITY, NULL) != pdPASS)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}// eo scan_pipeline_start::
+
+/*>>> scan_pipeline_ingest: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: 17/10/2026
+Desc: Ingest stage (runs in the network reactor): queue the barcode for allocation. If scan mode
+      is off, or SCAN_ALLOC_QUEUE_LEN barcodes are already waiting, a reject record (IDLE / BUSY)
+      is queued instead, in the SCAN_REJECT_RESERVE entries kept for them, so the answer still
+      leaves after the acks of earlier barcodes. Only when the queue is full as well is the
+      barcode dropped without an answer (counted in ack_drops).
+Input: net_conn_t *conn - Scanner connection, or NULL for a barcode that needs no answer.
+       const char *code - Barcode.
+       size_t len - Length of code.
+       bool accept - Scan mode on.
+Return: None
+=========================================================================================================*/
+void scan_pipeline_ingest(net_conn_t *conn, const char *code, size_t len, bool accept)
+{
+    scan_job_t job = { .conn = conn ? net_conn_id(conn) : NET_CONN_ID_NONE, .len = (uint8_t)len };
+    memcpy(job.code, code, len + 1);
+
+    if (!accept)
+    {
+        ESP_LOGW(TAG,"Scan mode off, ignoring '%s'", code);
+        job.reject = true;
+        job.status = SCAN_IDLE;
+    }
+    else if (s_jobs_queued - s_jobs_taken >= SCAN_ALLOC_QUEUE_LEN)
+    {
+        s_stats.alloc_drops++;
+        ESP_LOGW(TAG,"Allocate stage full, dropping '%s'", code);
+        job.reject = true;
+        job.status = SCAN_BUSY;
+    }
+
+    if (xQueueSend(s_alloc_q, &job, 0) != pdTRUE)
+    {
+        // a burst of rejects can fill the reserve and the free barcode entries alike
+        s_stats.ack_drops++;
+        ESP_LOGW(TAG,"Allocate queue full, '%s' not acknowledged", code);
+        return;
+    }
+    if (!job.reject)
+    {
+        // counted only once queued, or s_jobs_queued would run ahead of s_jobs_taken for good
+        s_stats.ingested++;
+        s_jobs_queued++;
+    }
+    UBaseType_t depth = uxQueueMessagesWaiting(s_alloc_q);
+    if (depth > s_stats.alloc_hwm) s_stats.alloc_hwm = depth;
+}// eo scan_pipeline_ingest::
+
+/*>>> scan_pipeline_update_occupancy: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Apply sensor occupancy without racing the allocate stage.
+Input: const bool ir[SHELF_SLOTS] - Occupancy per slot.
+Return: None
+=========================================================================================================*/
+void scan_pipeline_update_occupancy(const bool ir[SHELF_SLOTS])
+{
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    shelf_manager_update_from_sensors(ir);
+    xSemaphoreGive(s_lock);
+}// eo scan_pipeline_update_occupancy::
+
+/*>>> scan_pipeline_last: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Copy the last successfully decoded scan.
+Input: scan_record_t *out - Destination.
+Return: bool - false if nothing has been scanned yet.
+=========================================================================================================*/
+bool scan_pipeline_last(scan_record_t *out)
+{
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    bool have = s_has_last;
+    if (have) *out = s_last;
+    xSemaphoreGive(s_lock);
+    return have;
+}// eo scan_pipeline_last::
+
+/*>>> scan_pipeline_show_last: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: 17/10/2026
+Desc: Re-display the last scan through the render stage (SW2), so it is drawn exactly like a fresh
+      result.
+Input: None
+Return: esp_err_t - ESP_OK, ESP_ERR_NOT_FOUND if nothing has been scanned yet, or
+        ESP_ERR_NO_MEM if the render stage is full.
+=========================================================================================================*/
+esp_err_t scan_pipeline_show_last(void)
+{
+    scan_record_t rec;
+    if (!scan_pipeline_last(&rec))
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+    return (xQueueSend(s_render_q, &rec, 0) == pdTRUE) ? ESP_OK : ESP_ERR_NO_MEM;
+}// eo scan_pipeline_show_last::
+
+/*>>> scan_pipeline_get_stats: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Copy out the pipeline counters with the current queue depths.
+Input: scan_pipeline_stats_t *out - Destination.
+Return: None
+=========================================================================================================*/
+void scan_pipeline_get_stats(scan_pipeline_stats_t *out)
+{
+    *out = s_stats;
+    out->alloc_depth  = uxQueueMessagesWaiting(s_alloc_q);
+    out->render_depth = uxQueueMessagesWaiting(s_render_q);
+}// eo scan_pipeline_get_stats::
@@ -0,0 +1,89 @@
+/*======================================================================================================
+File Name:	scan_pipeline.h
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the interface for the staged scan pipeline. Barcodes flow through
+three stages connected by bounded FreeRTOS queues:
+    ingest   (network reactor)  → s_alloc_q  →
+    allocate (parse, pick slot, acknowledge) → s_render_q →
+    render   (compose the result toast)
+so allocation throughput depends only on parsing and the shelf lookup, never on the LCD.
+====================================================================================================*/
+
+#ifndef SCAN_PIPELINE_H
+#define SCAN_PIPELINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "item_sorting.h"
+#include "line_framer.h"
+#include "net_reactor.h"
+#include "shelf_manager.h"
+
+#define SCAN_ALLOC_QUEUE_LEN    8    // Barcodes waiting for allocation
+#define SCAN_REJECT_RESERVE     8    // Extra allocate-queue entries for IDLE / BUSY answers
+#define SCAN_RENDER_QUEUE_LEN   4    // Results waiting to be drawn
+#define SCAN_STAGE_STACK        3072 // Stack of each stage task
+#define SCAN_ALLOC_PRIORITY     5    // Same as the network task
+#define SCAN_RENDER_PRIORITY    4    // Same as the LCD render task
+
+typedef enum {
+    SCAN_OK,        // slot assigned
+    SCAN_FULL,      // valid barcode, zone full
+    SCAN_INVALID,   // barcode did not parse
+    SCAN_IDLE,      // scan mode off, barcode ignored
+    SCAN_BUSY,      // allocation queue full, barcode dropped
+} scan_status_t; // Outcome reported to the scanner station
+
+typedef struct {
+    scan_status_t status;
+    int           slot;   // shelf slot, -2 = Frozen Section, -1 = none
+    item_info_t   info;   // decoded item (OK / FULL)
+} scan_result_t; // Result of one barcode
+
+typedef struct {
+    char          code[LINE_FRAMER_MAX + 1]; // barcode
+    scan_result_t res;
+} scan_record_t; // Barcode with its result
+
+typedef struct {
+    uint32_t ingested;      // barcodes offered to the allocate stage
+    uint32_t allocated;     // barcodes processed by the allocate stage
+    uint32_t alloc_drops;   // dropped because the allocate queue was full
+    uint32_t ack_drops;     // rejected barcodes left unanswered (reject reserve full)
+    uint32_t render_drops;  // results replaced before they were drawn
+    uint32_t alloc_depth;   // current allocate queue depth
+    uint32_t alloc_hwm;     // highest allocate queue depth seen
+    uint32_t render_depth;  // current render queue depth
+    uint32_t render_hwm;    // highest render queue depth seen
+} scan_pipeline_stats_t; // Queue depths and drop counters
+
+/// Create the queues and the allocate and render stage tasks.
+esp_err_t scan_pipeline_start(void);
+
+/**
+ * @brief Ingest stage: queue a barcode for allocation without blocking. If
+ *        `accept` is false (scan mode off) or the queue is full, the scanner
+ *        is answered IDLE / BUSY, after the acks of its earlier barcodes.
+ *        `conn` may be NULL for a barcode that is not acknowledged.
+ */
+void scan_pipeline_ingest(net_conn_t *conn, const char *code, size_t len, bool accept);
+
+/// Apply sensor occupancy; serialised with slot allocation.
+void scan_pipeline_update_occupancy(const bool ir[SHELF_SLOTS]);
+
+/// Copy the last successfully decoded scan; false if there is none yet.
+bool scan_pipeline_last(scan_record_t *out);
+
+/// Queue the last scan for the render stage again; ESP_ERR_NOT_FOUND if there is
+/// none yet, ESP_ERR_NO_MEM if the render stage is full.
+esp_err_t scan_pipeline_show_last(void);
+
+void scan_pipeline_get_stats(scan_pipeline_stats_t *out);
+
+#endif // SCAN_PIPELINE_H
@@ -0,0 +1,85 @@
+/*======================================================================================================
+File Name:	sensor_frame.h
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	17/10/2026
+© Fanshawe College, 2025
+
+Description: This file contains the wire format shared by the transmitter and the primary
+controller. Frames have a fixed little-endian layout, so both sides encode and decode them with
+byte moves only (no printf/strtok/strtof). The same file is kept in both projects and must stay
+identical.
+
+Snapshot frame - complete sample, sent periodically and after every (re)connect:
+    off len field
+    0   1   SENSOR_FRAME_SYNC (0xA5, never the first byte of a CSV record)
+    1   1   version (SENSOR_FRAME_VERSION)
+    2   2   sequence number, +1 per frame
+    4   2   occupancy, bit i = slot i occupied
+    6   1   flags, bit 0 = spill
+    7   2   temperature, int16 in 0.01 °C
+    9   2   humidity, int16 in 0.01 %
+    11  2   CRC-16/CCITT-FALSE of bytes 0..10
+
+Delta frame - one slot changed, sent as soon as the edge is seen:
+    off len field
+    0   1   SENSOR_DELTA_SYNC (0xA6)
+    1   1   version (SENSOR_FRAME_VERSION)
+    2   2   sequence number, shared with snapshots
+    4   1   slot index
+    5   1   new state, 1 = occupied
+    6   2   CRC-16/CCITT-FALSE of bytes 0..5
+====================================================================================================*/
+
+#ifndef SENSOR_FRAME_H
+#define SENSOR_FRAME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define SENSOR_FRAME_SYNC     0xA5
+#define SENSOR_FRAME_VERSION  1
+#define SENSOR_FRAME_LEN      13   // Bytes on the wire
+#define SENSOR_FRAME_SPILL    0x01 // flags bit
+#define SENSOR_DELTA_SYNC     0xA6
+#define SENSOR_DELTA_LEN      8    // Bytes on the wire
+
+typedef struct {
+    uint16_t seq;        // sequence number
+    uint16_t occupancy;  // bit i = slot i occupied
+    bool     spill;      // spill detected
+    int16_t  temp_c;     // temperature in 0.01 °C
+    int16_t  hum_c;      // humidity in 0.01 %
+} sensor_frame_t; // One decoded sample
+
+typedef struct {
+    uint16_t seq;        // sequence number
+    uint8_t  slot;       // slot that changed
+    bool     occupied;   // its new state
+} sensor_delta_t; // One occupancy change
+
+typedef enum {
+    SENSOR_FRAME_OK,
+    SENSOR_FRAME_ERR_LEN,      // wrong length for the frame type
+    SENSOR_FRAME_ERR_SYNC,     // wrong sync byte for the frame type
+    SENSOR_FRAME_ERR_VERSION,  // unknown version
+    SENSOR_FRAME_ERR_CRC,      // corrupted
+} sensor_frame_err_t;
+
+/// Convert a float reading to 0.01 units, rounded and clamped to int16.
+int16_t sensor_frame_centi(float v);
+
+/// Encode `f` into `out` (SENSOR_FRAME_LEN bytes).
+void sensor_frame_encode(const sensor_frame_t *f, uint8_t out[SENSOR_FRAME_LEN]);
+
+/// Check and decode one frame.
+sensor_frame_err_t sensor_frame_decode(const uint8_t *buf, size_t len, sensor_frame_t *out);
+
+/// Encode `d` into `out` (SENSOR_DELTA_LEN bytes).
+void sensor_delta_encode(const sensor_delta_t *d, uint8_t out[SENSOR_DELTA_LEN]);
+
+/// Check and decode one delta frame.
+sensor_frame_err_t sensor_delta_decode(const uint8_t *buf, size_t len, sensor_delta_t *out);
+
+#endif // SENSOR_FRAME_H
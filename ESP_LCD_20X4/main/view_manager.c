@@ -0,0 +1,264 @@
+/*======================================================================================================
+File Name:	view_manager.c
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the implementation of the view manager. Each page declares which
+parts of the model it shows; model setters quantise to display resolution and flag only the parts
+that really changed, and a frame is composed and handed to the render task only when the visible
+page is affected. Toasts are timed overlays expired by a FreeRTOS software timer, so no task ever
+sleeps to hold a message on screen.
+====================================================================================================*/
+
+#include "view_manager.h"
+#include <math.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/timers.h"
+#include "lcd_render.h"
+
+// Parts of the model a page can be bound to
+#define VIEW_BIND_NONE  0x00
+#define VIEW_BIND_ENV   0x01 // temperature, humidity, spill
+
+#define VIEW_TIMER_LOCK_MS  10 // Longest the timer daemon waits for s_lock before retrying
+#define VIEW_TIMER_CMD_MS   10 // Longest a caller waits for room in the timer command queue
+
+typedef struct {
+    int16_t temp_d;   // temperature in 0.1 °C
+    int16_t hum_d;    // humidity in 0.1 %
+    bool    spill;    // spill detected
+} view_model_t; // Model values at display resolution
+
+typedef struct {
+    void   (*draw)(lcd20x4_frame_t *frame, const view_model_t *m);
+    uint8_t  binds;   // VIEW_BIND_* the page shows
+} view_page_desc_t; // Declared page
+
+static void draw_home(lcd20x4_frame_t *frame, const view_model_t *m);
+static void draw_scan(lcd20x4_frame_t *frame, const view_model_t *m);
+
+static const view_page_desc_t s_pages[VIEW_PAGE_COUNT] = {
+    [VIEW_PAGE_HOME] = { draw_home, VIEW_BIND_ENV  },
+    [VIEW_PAGE_SCAN] = { draw_scan, VIEW_BIND_NONE },
+};
+
+static const lcd20x4_glyph_t s_glyphs[VIEW_GLYPH_COUNT] = {
+    [VIEW_GLYPH_ALERT] = {{ 0x04, 0x0E, 0x0E, 0x0E, 0x04, 0x00, 0x04, 0x00 }}, // bold '!'
+};
+
+static SemaphoreHandle_t s_lock;          // guards everything below
+static TimerHandle_t     s_toast_timer;   // expires the active toast
+static view_model_t      s_model;         // current model
+static view_page_t       s_page;          // page under any toast
+static uint8_t           s_changed;       // VIEW_BIND_* changed since last draw
+static bool              s_page_dirty;    // page must be redrawn regardless of binds
+static bool              s_toast_active;  // a toast is covering the page
+static TickType_t        s_toast_until;   // tick the active toast expires at
+static uint32_t          s_toast_gen;     // bumped by every toast
+static lcd20x4_frame_t   s_toast;         // toast contents
+
+/*>>> draw_home: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Compose the idle page: title and live T/H, plus an alert icon while a spill is reported.
+Input: lcd20x4_frame_t *frame - Frame to draw into.
+       const view_model_t *m - Model values.
+Return: None
+=========================================================================================================*/
+static void draw_home(lcd20x4_frame_t *frame, const view_model_t *m)
+{
+    lcd20x4_frame_write(frame,0,0,"Barcode Sorting");
+    lcd20x4_frame_write(frame,0,1,"Waiting for scan:");
+    lcd20x4_frame_printf(frame,0,2,"Temp: %.1k%DC", m->temp_d); // %D = degree sign
+    lcd20x4_frame_printf(frame,0,3,"Hum:  %.1k %%", m->hum_d);
+    if (m->spill) lcd20x4_frame_glyph(frame,19,0,VIEW_GLYPH_ALERT);
+} // eo draw_home::
+
+/*>>> draw_scan: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Compose the scan-mode page.
+Input: lcd20x4_frame_t *frame - Frame to draw into.
+       const view_model_t *m - Model values (unused).
+Return: None
+=========================================================================================================*/
+static void draw_scan(lcd20x4_frame_t *frame, const view_model_t *m)
+{
+    (void)m;
+    lcd20x4_frame_write(frame,0,0,"Scan mode:");
+    lcd20x4_frame_write(frame,0,1,"Waiting for TCP");
+} // eo draw_scan::
+
+/*>>> view_refresh_locked: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Publish the page if it is visible and something it shows changed. Caller holds s_lock.
+Input: None
+Return: None
+=========================================================================================================*/
+static void view_refresh_locked(void)
+{
+    if (s_toast_active) return;
+    const view_page_desc_t *page = &s_pages[s_page];
+    if (!s_page_dirty && !(s_changed & page->binds)) return;
+
+    lcd20x4_frame_t frame;
+    lcd20x4_frame_clear(&frame);
+    page->draw(&frame, &s_model);
+    lcd_render_publish(&frame);
+    s_page_dirty = false;
+    s_changed    = 0;
+} // eo view_refresh_locked::
+
+/*>>> toast_expired: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: 17/10/2026
+Desc: Timer callback: drop the toast and bring the page back. Runs on the timer daemon, so it never
+      blocks on s_lock for long: if the lock is busy the timer is re-armed for the next tick. A
+      toast whose hold has not run out (the timer fired before a newer toast re-armed it) is left.
+Input: TimerHandle_t t - Toast timer.
+Return: None
+=========================================================================================================*/
+static void toast_expired(TimerHandle_t t)
+{
+    if (xSemaphoreTake(s_lock, pdMS_TO_TICKS(VIEW_TIMER_LOCK_MS)) != pdTRUE) {
+        xTimerChangePeriod(t, 1, 0);
+        return;
+    }
+    if (s_toast_active && (int32_t)(xTaskGetTickCount() - s_toast_until) >= 0) {
+        s_toast_active = false;
+        s_page_dirty   = true;
+        view_refresh_locked();
+    }
+    xSemaphoreGive(s_lock);
+} // eo toast_expired::
+
+/*>>> view_init: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Register glyphs, start the render task and draw the home page.
+Input: lcd_20x4_driver_t *lcd - Initialised LCD driver.
+Return: esp_err_t - ESP_OK, or ESP_ERR_NO_MEM.
+=========================================================================================================*/
+esp_err_t view_init(lcd_20x4_driver_t *lcd)
+{
+    lcd20x4_set_glyph_table(lcd, s_glyphs, VIEW_GLYPH_COUNT);
+    s_lock        = xSemaphoreCreateMutex();
+    s_toast_timer = xTimerCreate("toast", 1, pdFALSE, NULL, toast_expired);
+    if (!s_lock || !s_toast_timer) {
+        return ESP_ERR_NO_MEM;
+    }
+    esp_err_t err = lcd_render_start(lcd);
+    if (err != ESP_OK) {
+        return err;
+    }
+    view_set_page(VIEW_PAGE_HOME);
+    return ESP_OK;
+} // eo view_init::
+
+/*>>> view_set_page: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Switch the underlying page.
+Input: view_page_t page - Page to show.
+Return: None
+=========================================================================================================*/
+void view_set_page(view_page_t page)
+{
+    if (page >= VIEW_PAGE_COUNT) return;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (page != s_page || !s_toast_active) {
+        s_page       = page;
+        s_page_dirty = true;
+        view_refresh_locked();
+    }
+    xSemaphoreGive(s_lock);
+} // eo view_set_page::
+
+/*>>> view_set_env: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Update temperature, humidity and spill; redraw only on a change visible on the LCD.
+Input: float temp - Temperature in °C.
+       float hum - Relative humidity in %.
+       bool spill - Spill detected.
+Return: None
+=========================================================================================================*/
+void view_set_env(float temp, float hum, bool spill)
+{
+    view_model_t m = {
+        .temp_d = (int16_t)lroundf(temp * 10.0f),
+        .hum_d  = (int16_t)lroundf(hum  * 10.0f),
+        .spill  = spill,
+    };
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (m.temp_d != s_model.temp_d || m.hum_d != s_model.hum_d || m.spill != s_model.spill) {
+        s_model    = m;
+        s_changed |= VIEW_BIND_ENV;
+        view_refresh_locked();
+    }
+    xSemaphoreGive(s_lock);
+} // eo view_set_env::
+
+/*>>> view_toast: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: 17/10/2026
+Desc: Cover the page with `frame` for `ms` milliseconds. The timer is armed outside s_lock (its
+      callback takes the lock); if its command queue stays full the toast is dropped at once
+      rather than left on screen for good.
+Input: const lcd20x4_frame_t *frame - Toast contents.
+       uint32_t ms - Display time.
+Return: None
+=========================================================================================================*/
+void view_toast(const lcd20x4_frame_t *frame, uint32_t ms)
+{
+    TickType_t ticks = pdMS_TO_TICKS(ms);
+    if (!ticks) ticks = 1;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    s_toast        = *frame;
+    s_toast_active = true;
+    s_toast_until  = xTaskGetTickCount() + ticks;
+    uint32_t gen   = ++s_toast_gen;
+    lcd_render_publish(&s_toast);
+    xSemaphoreGive(s_lock);
+
+    // (re)starts the one-shot timer; a newer toast extends the hold
+    if (xTimerChangePeriod(s_toast_timer, ticks, pdMS_TO_TICKS(VIEW_TIMER_CMD_MS)) != pdPASS) {
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        if (s_toast_gen == gen) {
+            s_toast_active = false;
+            s_page_dirty   = true;
+            view_refresh_locked();
+        }
+        xSemaphoreGive(s_lock);
+    }
+} // eo view_toast::
+
+/*>>> view_toast_text: ======================================================================
+Author: Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date: 17/10/2026
+Modified: None
+Desc: Toast a single line of text on an otherwise blank screen.
+Input: const char *text - Text for the first row.
+       uint32_t ms - Display time.
+Return: None
+=========================================================================================================*/
+void view_toast_text(const char *text, uint32_t ms)
+{
+    lcd20x4_frame_t frame;
+    lcd20x4_frame_clear(&frame);
+    lcd20x4_frame_write(&frame,0,0,text);
+    view_toast(&frame, ms);
+} // eo view_toast_text::
@@ -0,0 +1,58 @@
+/*======================================================================================================
+File Name:	view_manager.h
+Author:		Vraj Patel, Vamseedhar Reddy, Samip Patel, Mihir Jariwala
+Date:		17/10/2026
+Modified:	None
+© Fanshawe College, 2025
+
+Description: This file contains the interface for the view manager, which owns what the primary
+controller's LCD shows: declared pages bound to model values, and timed toast overlays.
+====================================================================================================*/
+
+#ifndef VIEW_MANAGER_H
+#define VIEW_MANAGER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "lcd_20x4_driver.h"
+
+/// Pages the primary can show when no toast is active.
+typedef enum {
+    VIEW_PAGE_HOME,      // title + live T/H (+ spill icon)
+    VIEW_PAGE_SCAN,      // scan mode, waiting for a barcode
+    VIEW_PAGE_COUNT
+} view_page_t;
+
+/// Custom glyphs registered with the LCD (IDs for lcd20x4_frame_glyph()).
+typedef enum {
+    VIEW_GLYPH_ALERT,
+    VIEW_GLYPH_COUNT
+} view_glyph_t;
+
+/**
+ * @brief Register the glyphs with `lcd`, start the render task and draw the
+ *        home page. The render task owns `lcd` from here on.
+ */
+esp_err_t view_init(lcd_20x4_driver_t *lcd);
+
+/// Switch the underlying page (redraws only if it is not covered by a toast).
+void view_set_page(view_page_t page);
+
+/**
+ * Update the environment model. Pages bound to it redraw only when a value
+ * changes at display resolution (0.1 °C / 0.1 %), not on every update.
+ */
+void view_set_env(float temp, float hum, bool spill);
+
+/**
+ * Show a complete frame on top of the current page for `ms` milliseconds,
+ * then fall back to the page. A newer toast replaces an older one.
+ * Returns immediately.
+ */
+void view_toast(const lcd20x4_frame_t *frame, uint32_t ms);
+
+/// Convenience: toast a single line of text.
+void view_toast_text(const char *text, uint32_t ms);
+
+#endif // VIEW_MANAGER_H
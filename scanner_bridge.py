@@ -2,22 +2,70 @@
 #File Name: scanner_bridge.py
 # Author: Vraj Patel, Samip Patel, Mihir Jariwala, Vamseedhar Reddy
 # Date:		17/07/2025
-# Modified:	None
+# Modified:	17/10/2026
 # © Fanshawe College, 2025
 
 # Description: This file contains the implementation of the scanner bridge,
 # which facilitates communication between the barcode scanner and the ESP32.
 
 #!/usr/bin/env python3
+import collections
 import serial
 import socket
+import threading
 import time
+import urllib.parse
 
 SERIAL_PORT     = r'\\.\COM9'
 BAUD_RATE       = 9600
 TCP_IP, TCP_PORT = '192.168.4.1', 3334
 RECONNECT_DELAY = 5  # seconds
 
+# Barcodes sent but not yet acknowledged, oldest first: (barcode, send time).
+# The ESP32 answers every barcode in order with "ACK <status> <barcode> <slot> <reason>",
+# the barcode percent-encoded so that it is always one field.
+pending = collections.deque()
+
+#>>> read_acks=================================================================================================
+#Author:		Vamseedhar Reddy, Samip Patel, Mihir Jariwala, Vraj Patel
+#Date:		17/10/2026
+#Modified:	17/10/2026
+#Desc:		This function will print each acknowledgement from the ESP32 with
+#			the round-trip time of the scan it answers. Runs in its own thread
+#			so scans can be sent without waiting for their replies. The ack is
+#			matched to the oldest pending scan of the same barcode; scans queued
+#			before it that were never answered are dropped as lost. When the
+#			ESP32 ends the session (e.g. its idle timeout) the socket is shut
+#			down, so the next send fails and reconnects instead of being lost.
+#Input: 	- sock: Session socket to read from
+#Returns:	None
+
+def read_acks(sock):
+    try:
+        for raw in sock.makefile('rb'):
+            fields = raw.decode('utf-8', 'ignore').split()
+            if len(fields) != 5 or fields[0] != "ACK":
+                continue
+            _, status, barcode, slot, reason = fields
+            barcode = urllib.parse.unquote(barcode)
+            rtt = None
+            match = next((i for i, (code, _) in enumerate(list(pending)) if code == barcode), None)
+            if match is not None:
+                for _ in range(match):
+                    lost, _ = pending.popleft()
+                    print(f"[!] No ack for {lost}, giving up on it")
+                rtt = (time.monotonic() - pending.popleft()[1]) * 1000
+            detail = slot if status == "OK" else reason
+            timing = f" ({rtt:.0f} ms)" if rtt is not None else ""
+            print(f"← {barcode}: {status} {detail}{timing}")
+    except OSError:
+        pass
+    print("[!] Session closed by the ESP32")
+    try:
+        sock.shutdown(socket.SHUT_RDWR)
+    except OSError:
+        pass
+
 #>>> open_serial===============================================================================================
 #Author:		Vamseedhar Reddy, Samip Patel, Mihir Jariwala, Vraj Patel
 #Date:		17/07/2025
@@ -36,33 +84,69 @@ def open_serial():
             print(f"[!] Serial open failed: {e}")
             time.sleep(RECONNECT_DELAY)
 
+#>>> open_tcp================================================================================================
+#Author:		Vamseedhar Reddy, Samip Patel, Mihir Jariwala, Vraj Patel
+#Date:		17/10/2026
+#Modified:	17/10/2026
+#Desc:		This function will open the long-lived scan session to the ESP32,
+#			retrying until it succeeds, and start reading its acknowledgements.
+#Input: 	- None
+#Returns:	A connected socket.socket object.
+
+def open_tcp():
+    while True:
+        try:
+            sock = socket.create_connection((TCP_IP, TCP_PORT), timeout=5)
+            sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)  # one scan per segment, no Nagle delay
+            sock.settimeout(None)
+            print(f"[+] Connected to {TCP_IP}:{TCP_PORT}")
+            while pending:  # acks for a lost session never arrive
+                print(f"[!] No ack for {pending.popleft()[0]}, session was lost")
+            threading.Thread(target=read_acks, args=(sock,), daemon=True).start()
+            return sock
+        except Exception as e:
+            print(f"[!] TCP connect failed: {e}")
+            time.sleep(RECONNECT_DELAY)
+
 #>>> send_barcode=============================================================================================
 #Author:		Vamseedhar Reddy, Samip Patel, Mihir Jariwala, Vraj Patel
 #Date:		17/07/2025
-#Modified:	None
-#Desc:		This function will send a barcode string to the ESP32 over TCP.
-#Input: 	- barcode: The barcode string to send
-#Returns:	None
+#Modified:	17/10/2026
+#Desc:		This function will send a barcode string to the ESP32 over the
+#			scan session, reconnecting once if the session was lost.
+#Input: 	- sock: Current session socket, or None
+#			- barcode: The barcode string to send
+#Returns:	The socket to use for the next barcode.
 
-def send_barcode(barcode: str):
-    """Open a new socket, send one barcode, then close."""
-    try:
-        with socket.create_connection((TCP_IP, TCP_PORT), timeout=5) as sock:
-            print(f"[+] Connected to {TCP_IP}:{TCP_PORT}")
-            sock.sendall((barcode + "\n").encode('utf-8'))
-    except Exception as e:
-        print(f"[!] TCP send failed: {e}")
+def send_barcode(sock, barcode: str):
+    """Send one newline-terminated barcode over the persistent session."""
+    line = (barcode + "\n").encode('utf-8')
+    for _ in range(2):
+        if sock is None:
+            sock = open_tcp()
+        try:
+            pending.append((barcode, time.monotonic()))
+            sock.sendall(line)
+            return sock
+        except Exception as e:
+            print(f"[!] TCP send failed: {e}")
+            pending.pop()  # not sent: retried on the new session
+            sock.close()
+            sock = None
+    return sock
 
 #>>> bridge==================================================================================================
 #Author:		Vamseedhar Reddy, Samip Patel, Mihir Jariwala, Vraj Patel
 #Date:		17/07/2025
-#Modified:	None
-#Desc:		This function will bridge the serial and TCP connections.
+#Modified:	17/10/2026
+#Desc:		This function will bridge the serial port to one persistent TCP
+#			scan session.
 #Input: 	- None
 #Returns:	None
 
 def bridge():
     ser = open_serial()
+    sock = open_tcp()
     try:
         while True:
             raw = ser.readline()
@@ -71,10 +155,12 @@ def bridge():
             text = raw.decode('utf-8', 'ignore').strip()
             if text:
                 print(f"→ Scanned: {text}")
-                send_barcode(text)
+                sock = send_barcode(sock, text)
     except KeyboardInterrupt:
         print("\n[!] Interrupted by user, exiting…")
     finally:
+        if sock:
+            sock.close()
         ser.close()
 
 if __name__ == "__main__":